@@ -0,0 +1,102 @@
+/**
+ * @file BitSet.cpp
+ * @brief Implementation of the BitSet class.
+ * @details This file contains the implementation of the BitSet class: growing the set and the operations that work on whole words, which use the population count and trailing-zero count provided by Qt and compile to single instructions where the processor has them.
+ * @see BitSet.h for the declaration of the BitSet class.
+ * @author Group 3
+ */
+
+#include "include/models/BitSet.h"
+
+// Including necessary modules.
+#include <QtAlgorithms>
+
+/**
+ * @brief Gets the number of bits.
+ * @return The number of bits.
+ */
+int BitSet::size() const {
+    return length;
+}
+
+/**
+ * @brief Gets the number of words holding the bits.
+ * @return The number of words.
+ */
+int BitSet::wordCount() const {
+    return words.size();
+}
+
+/**
+ * @brief Reserves memory for a number of bits.
+ * @param count The number of bits to reserve space for.
+ */
+void BitSet::reserve(int count) {
+    words.reserve((count + 63) / 64);
+}
+
+/**
+ * @brief Adds a bit at the end.
+ * @details Starts a new word every 64 bits; the new word is 0, which keeps the tail clear.
+ * @param value The value of the new bit.
+ */
+void BitSet::append(bool value) {
+    if ((length & 63) == 0) {words.append(0);}
+    set(length++, value);
+}
+
+/**
+ * @brief Removes every bit.
+ */
+void BitSet::clear() {
+    words.clear();
+    length = 0;
+}
+
+/**
+ * @brief Gives the set a length with every bit clear.
+ * @param count The new number of bits.
+ */
+void BitSet::reset(int count) {
+    words.resize((count + 63) / 64);
+    words.fill(0);
+    length = count;
+}
+
+/**
+ * @brief Counts the bits that are set.
+ * @return The number of bits that are 1.
+ */
+int BitSet::count() const {
+    int total = 0;
+    for (quint64 word : words) {total += int(qPopulationCount(word));}
+    return total;
+}
+
+/**
+ * @brief Finds the next bit that is set.
+ * @param from The index to start searching at.
+ * @return The index of the first set bit at or after from, or -1 if there is none.
+ */
+int BitSet::nextSet(int from) const {
+    if (from >= length) {return -1;}
+    int index = from >> 6;
+    quint64 word = words.at(index) & (~quint64(0) << (from & 63)); // Dropping the bits before from.
+    while (word == 0) {
+        if (++index == words.size()) {return -1;}
+        word = words.at(index);
+    }
+    return (index << 6) + int(qCountTrailingZeroBits(word));
+}
+
+/**
+ * @brief Gives direct access to the words.
+ * @return Pointer to the first word.
+ */
+quint64 *BitSet::wordData() {
+    return words.data();
+}
+
+const quint64 *BitSet::wordData() const {
+    return words.constData();
+}
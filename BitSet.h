@@ -0,0 +1,111 @@
+/**
+ * @file BitSet.h
+ * @brief Defines the BitSet class, a growable array of bits packed into 64-bit words.
+ * @details This header file contains the declaration of the BitSet class. LedStore keeps its per-LED flags in bit sets, so that a million LEDs take 128 KiB per flag instead of a megabyte, and so that set operations and counts work on 64 LEDs at a time.
+ * @author Group 3
+ */
+
+#ifndef BITSET_H
+#define BITSET_H
+
+// Including necessary modules.
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @class BitSet
+ * @brief Array of bits packed into 64-bit words.
+ * @details Bit i lives in word i / 64 at position i % 64. Bits past size() in the last word are always 0, so words can be combined and counted without masking the tail. test() and set() are defined in the header since they run once per LED in the bulk loops; everything that works on whole words is in the source file.
+ * @author Group 3
+ */
+class BitSet {
+
+public:
+
+    /**
+     * @brief Gets the number of bits.
+     * @return int The number of bits.
+     */
+    int size() const;
+
+    /**
+     * @brief Gets the number of words holding the bits.
+     * @return int The number of words, size() / 64 rounded up.
+     */
+    int wordCount() const;
+
+    /**
+     * @brief Reserves memory for a number of bits.
+     * @param count The number of bits to reserve space for.
+     */
+    void reserve(int count);
+
+    /**
+     * @brief Adds a bit at the end.
+     * @param value The value of the new bit.
+     */
+    void append(bool value);
+
+    /**
+     * @brief Removes every bit.
+     */
+    void clear();
+
+    /**
+     * @brief Gives the set a length with every bit clear.
+     * @details Reuses the allocated words, so clearing a set of the same length every frame does not allocate.
+     * @param count The new number of bits.
+     */
+    void reset(int count);
+
+    /**
+     * @brief Reads a bit.
+     * @param index The index of the bit. Must be less than size().
+     * @return bool The value of the bit.
+     */
+    bool test(int index) const {
+        return (words.at(index >> 6) >> (index & 63)) & 1;
+    }
+
+    /**
+     * @brief Writes a bit.
+     * @param index The index of the bit. Must be less than size().
+     * @param value The new value of the bit.
+     */
+    void set(int index, bool value) {
+        const quint64 mask = quint64(1) << (index & 63);
+        if (value) {words[index >> 6] |= mask;}
+        else {words[index >> 6] &= ~mask;}
+    }
+
+    /**
+     * @brief Counts the bits that are set.
+     * @details Uses one population count per word.
+     * @return int The number of bits that are 1.
+     */
+    int count() const;
+
+    /**
+     * @brief Finds the next bit that is set.
+     * @details Skips 64 bits at a time while the words are 0, so iterating over a sparse set costs little more than its number of set bits.
+     * @param from The index to start searching at.
+     * @return int The index of the first set bit at or after from, or -1 if there is none.
+     */
+    int nextSet(int from) const;
+
+    /**
+     * @brief Gives direct access to the words.
+     * @details Callers writing words must leave the bits past size() at 0.
+     * @return quint64* Pointer to the first of wordCount() words.
+     */
+    quint64 *wordData();
+    const quint64 *wordData() const;
+
+private:
+
+    QVector<quint64> words; // The bits, 64 per word.
+    int length = 0; // Number of bits.
+
+};
+
+#endif // BITSET_H
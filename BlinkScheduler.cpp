@@ -0,0 +1,97 @@
+/**
+ * @file BlinkScheduler.cpp
+ * @brief Implementation of the BlinkScheduler class.
+ * @details This file contains the implementation of the BlinkScheduler class, including the per-frame pass that derives blink phases from the monotonic clock and the process-wide wakeup counter.
+ * @see BlinkScheduler.h for the declaration of the BlinkScheduler class.
+ * @author Group 3
+ */
+
+#include "include/models/BlinkScheduler.h"
+#include "include/utils/Trace.h"
+
+// Including necessary modules.
+#include <QtAlgorithms>
+
+QAtomicInteger<quint64> BlinkScheduler::wakeups(0);
+
+/**
+ * @brief Constructs a BlinkScheduler.
+ * @details Sets up a precise frame timer so that blink phases are sampled at a steady rate.
+ * @param store The store holding the blink periods and phases.
+ * @param parent The parent object.
+ */
+BlinkScheduler::BlinkScheduler(LedStore *store, QObject *parent) : QObject(parent), store(store), frameTimer(new QTimer(this)) {
+    frameTimer->setTimerType(Qt::PreciseTimer);
+    frameTimer->setInterval(FrameInterval);
+    connect(frameTimer, &QTimer::timeout, this, &BlinkScheduler::tick);
+}
+
+/**
+ * @brief Starts ticking if it is not already running.
+ * @details The first tick happens immediately so that a newly blinking LED picks up its phase without waiting a frame.
+ */
+void BlinkScheduler::wake() {
+    if (!frameTimer->isActive()) {
+        frameTimer->start();
+        tick();
+    }
+}
+
+/**
+ * @brief Checks if the frame timer is running.
+ * @return True while at least one LED was blinking at the last tick.
+ */
+bool BlinkScheduler::isActive() const {
+    return frameTimer->isActive();
+}
+
+/**
+ * @brief Records one timer wakeup.
+ */
+void BlinkScheduler::countWakeup() {
+    wakeups.fetchAndAddRelaxed(1);
+}
+
+/**
+ * @brief Gets the number of timer wakeups since the application started.
+ * @return The total number of recorded wakeups.
+ */
+quint64 BlinkScheduler::wakeupCount() {
+    return wakeups.loadRelaxed();
+}
+
+/**
+ * @brief Updates the blink phase of every LED.
+ * @details An LED is lit while (t / period) % 2 is 0. LEDs that are off or not blinking are kept in the lit phase. The pass works on 64 LEDs at a time: the blinking LEDs of a word are the intersection of the on/off and periodic words, only their periods are read, and every other bit of the phase word is set. Only the LEDs whose phase flipped are marked dirty, and the view is only notified if at least one phase actually changed.
+ */
+void BlinkScheduler::tick() {
+
+    Trace::Span span("BlinkScheduler::tick");
+
+    countWakeup();
+
+    const qint64 t = store->now();
+    const int count = store->slotCount();
+    const quint64 *on = store->onBits().wordData();
+    const quint64 *periodic = store->periodicBits().wordData();
+    const int *periods = store->blinkPeriodData();
+    const int words = store->blinkPhaseBits().wordCount();
+    const quint64 tail = (count & 63) ? (quint64(1) << (count & 63)) - 1 : ~quint64(0); // Bits of the last word that hold slots.
+
+    bool anyChanged = false;
+
+    for (int w = 0; w < words; ++w) {
+        const quint64 blinking = on[w] & periodic[w];
+        quint64 lit = ~blinking;
+        for (quint64 rest = blinking; rest != 0; rest &= rest - 1) { // Visiting the blinking LEDs of the word only.
+            const int bit = int(qCountTrailingZeroBits(rest));
+            if (((t / periods[(w << 6) + bit]) & 1) == 0) {lit |= quint64(1) << bit;}
+        }
+        if (w == words - 1) {lit &= tail;} // Keeping the bits past the last slot clear.
+        anyChanged |= store->setBlinkPhaseWord(w, lit); // Marking the LEDs whose phase flipped dirty.
+    }
+
+    if (store->blinkingCount() == 0) {frameTimer->stop();} // Nothing left to blink, so stop waking up.
+    if (anyChanged) {emit phasesChanged();}
+
+}
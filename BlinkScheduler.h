@@ -0,0 +1,90 @@
+/**
+ * @file BlinkScheduler.h
+ * @brief Defines the BlinkScheduler class, which drives the blinking of every LED from one timer.
+ * @details This header file contains the declaration of the BlinkScheduler class. Instead of one QTimer per blinking LED, a single frame timer derives every LED's blink phase from the store's monotonic clock and the LED's blink period. The scheduler also keeps a process-wide count of timer wakeups so that the cost of timer dispatch can be measured.
+ * @author Group 3
+ */
+
+#ifndef BLINKSCHEDULER_H
+#define BLINKSCHEDULER_H
+
+#include "include/models/LedStore.h"
+
+// Including necessary modules.
+#include <QAtomicInteger>
+#include <QObject>
+#include <QTimer>
+
+/**
+ * @class BlinkScheduler
+ * @brief Computes the blink phase of all LEDs once per frame.
+ * @details An LED with blink period p is lit while (t / p) % 2 == 0, where t is the time on the store's clock, so changing the period is a single write to the store. The frame timer only runs while at least one LED that is on has a non-zero period.
+ * @author Group 3
+ */
+class BlinkScheduler : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructor for BlinkScheduler.
+     * @details Creates the frame timer without starting it.
+     * @param store The store holding the blink periods and phases.
+     * @param parent The parent object.
+     */
+    explicit BlinkScheduler(LedStore *store, QObject *parent = nullptr);
+
+    /**
+     * @brief Starts ticking if it is not already running.
+     * @details Must be called after a blink period has been set. If no LED turns out to be blinking, the scheduler stops again on its next tick.
+     */
+    void wake();
+
+    /**
+     * @brief Checks if the frame timer is running.
+     * @return bool True while at least one LED was blinking at the last tick.
+     */
+    bool isActive() const;
+
+    /**
+     * @brief Records one timer wakeup.
+     * @details Called from every timer callback in the application so that wakeups per second can be measured.
+     */
+    static void countWakeup();
+
+    /**
+     * @brief Gets the number of timer wakeups since the application started.
+     * @return quint64 The total number of wakeups recorded by countWakeup().
+     */
+    static quint64 wakeupCount();
+
+    /**
+     * @brief Interval between two frames in milliseconds.
+     */
+    static const int FrameInterval = 16;
+
+signals:
+
+    /**
+     * @brief Signal emitted when at least one LED changed its blink phase during a tick.
+     */
+    void phasesChanged();
+
+private slots:
+
+    /**
+     * @brief Updates the blink phase of every LED.
+     * @details Walks the on/off, period and phase arrays once, writing the phase derived from the current time. Stops the frame timer if no LED is blinking.
+     */
+    void tick();
+
+private:
+
+    LedStore *store; // Store holding the LED state.
+    QTimer *frameTimer; // Single timer driving all blinking.
+    static QAtomicInteger<quint64> wakeups; // Timer wakeups recorded so far.
+
+};
+
+#endif // BLINKSCHEDULER_H
@@ -0,0 +1,176 @@
+/**
+ * @file ColorCorrection.cpp
+ * @brief Implementation of the ColorCorrection class.
+ * @details This file contains the implementation of the ColorCorrection class. The tables hold entries with the level already shifted to its channel, so a corrected color is assembled with three lookups and three ORs and no shifts or masks beyond reading the channels. The vector implementations of dither() widen the residual bytes to 16 bits next to the linear channels, add them, and narrow the sums back with unsigned saturation, which never saturates as each byte's sum is below 256 once shifted or masked.
+ * @see ColorCorrection.h for the declaration of the ColorCorrection class.
+ * @author Group 3
+ */
+
+#include "include/utils/ColorCorrection.h"
+#include "include/utils/CpuFeatures.h"
+
+// Including necessary modules.
+#include <QtMath>
+
+#ifdef PILLUMINATE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Scalar implementation of ColorCorrection::dither().
+ * @details Also finishes the colors left over by the vector implementations.
+ */
+void ditherScalar(const quint64 *linear, quint32 *residuals, QRgb *colors, int count) {
+    for (int k = 0; k < count; ++k) {
+        quint32 color = 0;
+        quint32 residual = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            const quint32 sum = quint32((linear[k] >> (2 * shift)) & 0xffff) + ((residuals[k] >> shift) & 0xff);
+            color |= (sum >> 8) << shift;
+            residual |= (sum & 0xff) << shift;
+        }
+        colors[k] = color;
+        residuals[k] = residual;
+    }
+}
+
+#ifdef PILLUMINATE_X86_SIMD
+
+/**
+ * @brief SSE2 implementation of ColorCorrection::dither(), 4 colors per iteration.
+ */
+PILLUMINATE_TARGET("sse2") void ditherSse2(const quint64 *linear, quint32 *residuals, QRgb *colors, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i fraction = _mm_set1_epi16(0xff);
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const __m128i residual = _mm_loadu_si128(reinterpret_cast<const __m128i*>(residuals + k));
+        const __m128i low = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(linear + k)), _mm_unpacklo_epi8(residual, zero));
+        const __m128i high = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(linear + k + 2)), _mm_unpackhi_epi8(residual, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colors + k), _mm_packus_epi16(_mm_srli_epi16(low, 8), _mm_srli_epi16(high, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(residuals + k), _mm_packus_epi16(_mm_and_si128(low, fraction), _mm_and_si128(high, fraction)));
+    }
+    ditherScalar(linear + k, residuals + k, colors + k, count - k);
+}
+
+/**
+ * @brief AVX2 implementation of ColorCorrection::dither(), 8 colors per iteration.
+ * @details Unpacking and packing work within 128-bit halves, so the linear colors are regrouped into the pairs the unpacked residuals line up with: colors 0, 1, 4 and 5, then 2, 3, 6 and 7. Packing then puts all eight back in order.
+ */
+PILLUMINATE_TARGET("avx2") void ditherAvx2(const quint64 *linear, quint32 *residuals, QRgb *colors, int count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i fraction = _mm256_set1_epi16(0xff);
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        const __m256i residual = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(residuals + k));
+        const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(linear + k));
+        const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(linear + k + 4));
+        const __m256i low = _mm256_add_epi16(_mm256_permute2x128_si256(first, second, 0x20), _mm256_unpacklo_epi8(residual, zero));
+        const __m256i high = _mm256_add_epi16(_mm256_permute2x128_si256(first, second, 0x31), _mm256_unpackhi_epi8(residual, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colors + k), _mm256_packus_epi16(_mm256_srli_epi16(low, 8), _mm256_srli_epi16(high, 8)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(residuals + k), _mm256_packus_epi16(_mm256_and_si256(low, fraction), _mm256_and_si256(high, fraction)));
+    }
+    ditherScalar(linear + k, residuals + k, colors + k, count - k);
+}
+
+#endif
+
+}
+
+/**
+ * @brief Compares two sets of parameters.
+ * @param other The other parameters.
+ * @return True if all parameters are equal.
+ */
+bool ColorCorrection::Parameters::operator==(const Parameters &other) const {
+    return gamma == other.gamma && brightness == other.brightness && red == other.red && green == other.green && blue == other.blue;
+}
+
+/**
+ * @brief Compares two sets of parameters.
+ * @param other The other parameters.
+ * @return True if any parameter differs.
+ */
+bool ColorCorrection::Parameters::operator!=(const Parameters &other) const {
+    return !(*this == other);
+}
+
+/**
+ * @brief Constructor for ColorCorrection.
+ */
+ColorCorrection::ColorCorrection() {
+    rebuild();
+}
+
+/**
+ * @brief Sets the parameters.
+ * @param parameters The new parameters.
+ * @return True if the parameters changed.
+ */
+bool ColorCorrection::setParameters(const Parameters &parameters) {
+    Parameters limited;
+    limited.gamma = qBound(0.1, parameters.gamma, 5.0);
+    limited.brightness = qBound(0.0, parameters.brightness, 1.0);
+    limited.red = qBound(0.0, parameters.red, 1.0);
+    limited.green = qBound(0.0, parameters.green, 1.0);
+    limited.blue = qBound(0.0, parameters.blue, 1.0);
+    if (limited == current) {return false;}
+    current = limited;
+    rebuild();
+    return true;
+}
+
+/**
+ * @brief Gets the parameters.
+ * @return The current parameters.
+ */
+const ColorCorrection::Parameters &ColorCorrection::parameters() const {
+    return current;
+}
+
+/**
+ * @brief Tells whether the correction leaves every color unchanged.
+ * @return True if every table maps each level to itself.
+ */
+bool ColorCorrection::isIdentity() const {
+    return identity;
+}
+
+/**
+ * @brief Quantizes linear colors to 8 bits per channel with temporal error diffusion.
+ * @param linear The linear colors.
+ * @param residuals The residual of each color, updated in place.
+ * @param colors The 8-bit colors to write.
+ * @param count The number of colors.
+ */
+void ColorCorrection::dither(const quint64 *linear, quint32 *residuals, QRgb *colors, int count) {
+#ifdef PILLUMINATE_X86_SIMD
+    const CpuFeatures::Level level = CpuFeatures::level();
+    if (level == CpuFeatures::Avx2) {ditherAvx2(linear, residuals, colors, count); return;}
+    if (level == CpuFeatures::Sse2) {ditherSse2(linear, residuals, colors, count); return;}
+#endif
+    ditherScalar(linear, residuals, colors, count);
+}
+
+/**
+ * @brief Rebuilds the tables from the current parameters.
+ * @details 8-bit levels are rounded to the nearest step and linear levels to the nearest 1/256 of a step. The identity check compares the finished tables rather than the parameters, so parameters too close to the defaults to change any level skip the correction as well.
+ */
+void ColorCorrection::rebuild() {
+    identity = true;
+    for (int level = 0; level < 256; ++level) {
+        const double linear = qPow(level / 255.0, current.gamma) * current.brightness * 255.0;
+        const quint32 red = quint32(qRound(linear * current.red));
+        const quint32 green = quint32(qRound(linear * current.green));
+        const quint32 blue = quint32(qRound(linear * current.blue));
+        redLevels[level] = red << 16;
+        greenLevels[level] = green << 8;
+        blueLevels[level] = blue;
+        redLinear[level] = quint64(qRound(linear * current.red * 256.0)) << 32;
+        greenLinear[level] = quint64(qRound(linear * current.green * 256.0)) << 16;
+        blueLinear[level] = quint64(qRound(linear * current.blue * 256.0));
+        if (red != quint32(level) || green != quint32(level) || blue != quint32(level)) {identity = false;}
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file ColorCorrection.h
+ * @brief Defines the ColorCorrection class, which turns the colors picked for the LEDs into the colors they output.
+ * @details This header file contains the declaration of the ColorCorrection class. Gamma, global brightness and per-channel white balance are folded into one lookup table per channel, so correcting a color costs three table lookups however many adjustments are made. A second set of tables keeps the corrected levels at 16 bits, for temporal dithering to spread over frames what 8 bits cannot resolve.
+ * @author Group 3
+ */
+
+#ifndef COLORCORRECTION_H
+#define COLORCORRECTION_H
+
+// Including necessary modules.
+#include <QRgb>
+#include <QtGlobal>
+
+/**
+ * @class ColorCorrection
+ * @brief Gamma, brightness and white balance correction through lookup tables.
+ * @details Each channel is first raised to the gamma, which maps the perceptually even steps of picked colors to the linear light of an LED, and then scaled by the brightness and by its white balance factor. The tables are only rebuilt when the parameters change. Alpha is passed through unchanged. Linear colors pack four 16-bit channels into 64 bits in the byte order of QRgb, blue in the lowest bits. Each channel is an 8.8 fixed-point level from 0 to 255.0, so adding a dithering residual below 1 never overflows 16 bits, and alpha is kept as its 8-bit level in the upper byte of its channel. dither() turns a frame of linear colors into 8-bit colors, carrying each LED's rounding error over to its next frame so that the average over frames matches the linear level; it has an AVX2, an SSE2 and a scalar implementation selected by CpuFeatures, with bit-identical results.
+ * @author Group 3
+ */
+class ColorCorrection {
+
+public:
+
+    /**
+     * @brief Parameters of the correction.
+     * @details The default parameters leave every color unchanged.
+     */
+    struct Parameters {
+        double gamma = 1.0; ///< Exponent applied to each channel, from 0.1 to 5; LEDs typically need 2.2 to 2.8.
+        double brightness = 1.0; ///< Factor applied to every channel, from 0 to 1.
+        double red = 1.0; ///< White balance factor of the red channel, from 0 to 1.
+        double green = 1.0; ///< White balance factor of the green channel, from 0 to 1.
+        double blue = 1.0; ///< White balance factor of the blue channel, from 0 to 1.
+
+        /**
+         * @brief Compares two sets of parameters.
+         * @param other The other parameters.
+         * @return bool True if all parameters are equal.
+         */
+        bool operator==(const Parameters &other) const;
+
+        /**
+         * @brief Compares two sets of parameters.
+         * @param other The other parameters.
+         * @return bool True if any parameter differs.
+         */
+        bool operator!=(const Parameters &other) const;
+    };
+
+    /**
+     * @brief Constructor for ColorCorrection.
+     * @details Starts with the default parameters, which leave every color unchanged.
+     */
+    ColorCorrection();
+
+    /**
+     * @brief Sets the parameters.
+     * @details Rebuilds the tables if the parameters, once limited to their ranges, differ from the current ones.
+     * @param parameters The new parameters.
+     * @return bool True if the parameters changed.
+     */
+    bool setParameters(const Parameters &parameters);
+
+    /**
+     * @brief Gets the parameters.
+     * @return const Parameters& The current parameters, limited to their ranges.
+     */
+    const Parameters &parameters() const;
+
+    /**
+     * @brief Tells whether the correction leaves every color unchanged.
+     * @return bool True if every table maps each level to itself.
+     */
+    bool isIdentity() const;
+
+    /**
+     * @brief Corrects one color.
+     * @param rgba The color as ARGB32.
+     * @return QRgb The corrected color, with the same alpha.
+     */
+    QRgb map(QRgb rgba) const {
+        return (rgba & 0xff000000u) | redLevels[qRed(rgba)] | greenLevels[qGreen(rgba)] | blueLevels[qBlue(rgba)];
+    }
+
+    /**
+     * @brief Corrects one color to 16 bits per channel.
+     * @param rgba The color as ARGB32.
+     * @return quint64 The corrected linear color, with the same alpha.
+     */
+    quint64 mapLinear(QRgb rgba) const {
+        return (quint64(qAlpha(rgba)) << 56) | redLinear[qRed(rgba)] | greenLinear[qGreen(rgba)] | blueLinear[qBlue(rgba)];
+    }
+
+    /**
+     * @brief Quantizes linear colors to 8 bits per channel with temporal error diffusion.
+     * @details Each channel outputs the integer part of its level plus its residual and keeps the fractional part as its new residual, so a level of 10.25 shows as 11 once every four frames and as 10 otherwise.
+     * @param linear The linear colors.
+     * @param residuals The residual of each color, one byte per channel in the byte order of QRgb, updated in place. Zero for a color seen for the first time.
+     * @param colors The 8-bit colors to write.
+     * @param count The number of colors.
+     */
+    static void dither(const quint64 *linear, quint32 *residuals, QRgb *colors, int count);
+
+private:
+
+    Parameters current; // Parameters the tables were built for.
+    bool identity = true; // Whether every table maps each level to itself.
+    quint32 redLevels[256]; // Corrected red level of each red level, already shifted into place.
+    quint32 greenLevels[256]; // Corrected green level of each green level, already shifted into place.
+    quint32 blueLevels[256]; // Corrected blue level of each blue level.
+    quint64 redLinear[256]; // Corrected 8.8 fixed-point red level of each red level, already shifted into place.
+    quint64 greenLinear[256]; // Corrected 8.8 fixed-point green level of each green level, already shifted into place.
+    quint64 blueLinear[256]; // Corrected 8.8 fixed-point blue level of each blue level.
+
+    /**
+     * @brief Rebuilds the tables from the current parameters.
+     */
+    void rebuild();
+
+};
+
+#endif // COLORCORRECTION_H
@@ -0,0 +1,400 @@
+/**
+ * @file ColorSpaces.cpp
+ * @brief Implementation of the ColorSpaces class.
+ * @details This file contains the scalar, SSE2 and AVX2 implementations of the color space conversions and the dispatch between them. Instead of picking the sector of the hue and then the channel the sector puts where, every channel is computed with the same clamped distance from its own hue, so the vector implementations need no shuffles and no branches. They process 4 or 8 colors per iteration in 32-bit lanes and hand the remaining colors to the scalar implementation.
+ * @see ColorSpaces.h for the declaration of the ColorSpaces class.
+ * @author Group 3
+ */
+
+#include "include/utils/ColorSpaces.h"
+#include "include/utils/CpuFeatures.h"
+
+#ifdef PILLUMINATE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const float InverseByte = 1.0f / 255; // Turns a channel into a fraction.
+const float SixthsPerDegree = 1.0f / 60; // Turns a hue into sixths of the color wheel.
+const float TwelfthsPerDegree = 1.0f / 30; // Turns a hue into twelfths of the color wheel.
+
+/**
+ * @brief Packs channels into an opaque color.
+ * @param r The red channel.
+ * @param g The green channel.
+ * @param b The blue channel.
+ * @return The color.
+ */
+inline QRgb opaque(int r, int g, int b) {
+    return 0xff000000u | (quint32(r) << 16) | (quint32(g) << 8) | quint32(b);
+}
+
+/**
+ * @brief Gets one channel of an HSV color.
+ * @details The channel is the value within a sixth of the wheel of its own hue, falls linearly by the chroma over the next sixth and stays there for the opposite half.
+ * @param offset The offset of the channel in sixths: 5 for red, 3 for green and 1 for blue.
+ * @param sixths The hue in sixths of the wheel.
+ * @param value The value.
+ * @param chroma The difference between the largest and the smallest channel.
+ * @return The channel.
+ */
+inline int hsvChannel(float offset, float sixths, float value, float chroma) {
+    float k = offset + sixths;
+    if (k >= 6.0f) {k -= 6.0f;}
+    const float weight = qMax(0.0f, qMin(1.0f, qMin(k, 4.0f - k)));
+    return int(value - chroma * weight + 0.5f);
+}
+
+/**
+ * @brief Gets one channel of an HSL color.
+ * @details The channel is lightness plus the half chroma within a sixth of the wheel of its own hue, crosses over linearly to lightness minus the half chroma over the next sixth and stays there for the opposite third.
+ * @param offset The offset of the channel in twelfths: 0 for red, 8 for green and 4 for blue.
+ * @param twelfths The hue in twelfths of the wheel.
+ * @param lightness The lightness.
+ * @param halfChroma Half the difference between the largest and the smallest channel.
+ * @return The channel.
+ */
+inline int hslChannel(float offset, float twelfths, float lightness, float halfChroma) {
+    float k = offset + twelfths;
+    if (k >= 12.0f) {k -= 12.0f;}
+    const float weight = qMax(-1.0f, qMin(1.0f, qMin(k - 3.0f, 9.0f - k)));
+    return int(lightness - halfChroma * weight + 0.5f);
+}
+
+/**
+ * @brief Scalar implementation of ColorSpaces::hsvToRgb().
+ * @details The scalar implementations also finish the colors left over by the vector implementations.
+ */
+void hsvToRgbScalar(const ColorSpaces::Hsv *hsv, QRgb *colors, int count) {
+    for (int k = 0; k < count; ++k) {
+        const bool gray = hsv[k].hue < 0;
+        const float sixths = gray ? 0.0f : float(hsv[k].hue) * SixthsPerDegree;
+        const float value = float(hsv[k].value);
+        const float chroma = gray ? 0.0f : value * float(hsv[k].saturation) * InverseByte;
+        colors[k] = opaque(hsvChannel(5.0f, sixths, value, chroma), hsvChannel(3.0f, sixths, value, chroma), hsvChannel(1.0f, sixths, value, chroma));
+    }
+}
+
+/**
+ * @brief Scalar implementation of ColorSpaces::hslToRgb().
+ */
+void hslToRgbScalar(const ColorSpaces::Hsl *hsl, QRgb *colors, int count) {
+    for (int k = 0; k < count; ++k) {
+        const bool gray = hsl[k].hue < 0;
+        const float twelfths = gray ? 0.0f : float(hsl[k].hue) * TwelfthsPerDegree;
+        const float lightness = float(hsl[k].lightness);
+        const float halfChroma = gray ? 0.0f : float(hsl[k].saturation) * qMin(lightness, 255.0f - lightness) * InverseByte;
+        colors[k] = opaque(hslChannel(0.0f, twelfths, lightness, halfChroma), hslChannel(8.0f, twelfths, lightness, halfChroma), hslChannel(4.0f, twelfths, lightness, halfChroma));
+    }
+}
+
+/**
+ * @brief Scalar implementation of ColorSpaces::rgbToHsv().
+ */
+void rgbToHsvScalar(const QRgb *colors, ColorSpaces::Hsv *hsv, int count) {
+    for (int k = 0; k < count; ++k) {
+        const int r = qRed(colors[k]);
+        const int g = qGreen(colors[k]);
+        const int b = qBlue(colors[k]);
+        const int max = qMax(r, qMax(g, b));
+        const int delta = max - qMin(r, qMin(g, b));
+        hsv[k].value = quint8(max);
+        if (delta == 0) {
+            hsv[k].hue = -1;
+            hsv[k].saturation = 0;
+            continue;
+        }
+        const float chroma = float(delta);
+        float sixths;
+        if (max == r) {sixths = 0.0f + float(g - b) / chroma;}
+        else if (max == g) {sixths = 2.0f + float(b - r) / chroma;}
+        else {sixths = 4.0f + float(r - g) / chroma;}
+        float hue = sixths * 60.0f;
+        if (hue < 0.0f) {hue += 360.0f;}
+        hsv[k].hue = qint16(hue);
+        hsv[k].saturation = quint8(chroma * 255.0f / float(max) + 0.5f);
+    }
+}
+
+#ifdef PILLUMINATE_X86_SIMD
+
+// SSE2: 4 colors per iteration. SSE2 has no blend, so selections are built from masks.
+
+/**
+ * @brief Unpacks one byte of four packed colors into floats.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128 byte4(__m128i packed, int shift) {
+    return _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, shift), _mm_set1_epi32(255)));
+}
+
+/**
+ * @brief Picks lanes of one vector where a mask is set and of another elsewhere.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128 select4(__m128 mask, __m128 set, __m128 unset) {
+    return _mm_or_ps(_mm_and_ps(mask, set), _mm_andnot_ps(mask, unset));
+}
+
+/**
+ * @brief Packs four rounded channels of each color into opaque colors.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128i opaque4(__m128 r, __m128 g, __m128 b) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128i ri = _mm_cvttps_epi32(_mm_add_ps(r, half));
+    const __m128i gi = _mm_cvttps_epi32(_mm_add_ps(g, half));
+    const __m128i bi = _mm_cvttps_epi32(_mm_add_ps(b, half));
+    const __m128i rg = _mm_or_si128(_mm_slli_epi32(ri, 16), _mm_slli_epi32(gi, 8));
+    return _mm_or_si128(_mm_or_si128(rg, bi), _mm_set1_epi32(int(0xff000000u)));
+}
+
+/**
+ * @brief hsvChannel() on four lanes, before rounding.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128 hsvChannel4(float offset, __m128 sixths, __m128 value, __m128 chroma) {
+    const __m128 turn = _mm_set1_ps(6.0f);
+    __m128 k = _mm_add_ps(_mm_set1_ps(offset), sixths);
+    k = _mm_sub_ps(k, _mm_and_ps(_mm_cmpge_ps(k, turn), turn));
+    const __m128 weight = _mm_max_ps(_mm_setzero_ps(), _mm_min_ps(_mm_set1_ps(1.0f), _mm_min_ps(k, _mm_sub_ps(_mm_set1_ps(4.0f), k))));
+    return _mm_sub_ps(value, _mm_mul_ps(chroma, weight));
+}
+
+/**
+ * @brief hslChannel() on four lanes, before rounding.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128 hslChannel4(float offset, __m128 twelfths, __m128 lightness, __m128 halfChroma) {
+    const __m128 turn = _mm_set1_ps(12.0f);
+    __m128 k = _mm_add_ps(_mm_set1_ps(offset), twelfths);
+    k = _mm_sub_ps(k, _mm_and_ps(_mm_cmpge_ps(k, turn), turn));
+    const __m128 distance = _mm_min_ps(_mm_sub_ps(k, _mm_set1_ps(3.0f)), _mm_sub_ps(_mm_set1_ps(9.0f), k));
+    const __m128 weight = _mm_max_ps(_mm_set1_ps(-1.0f), _mm_min_ps(_mm_set1_ps(1.0f), distance));
+    return _mm_sub_ps(lightness, _mm_mul_ps(halfChroma, weight));
+}
+
+/**
+ * @brief SSE2 implementation of ColorSpaces::hsvToRgb().
+ */
+PILLUMINATE_TARGET("sse2") void hsvToRgbSse2(const ColorSpaces::Hsv *hsv, QRgb *colors, int count) {
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hsv + k));
+        const __m128i hue = _mm_srai_epi32(_mm_slli_epi32(packed, 16), 16);
+        const __m128 gray = _mm_castsi128_ps(_mm_srai_epi32(hue, 31));
+        const __m128 sixths = _mm_andnot_ps(gray, _mm_mul_ps(_mm_cvtepi32_ps(hue), _mm_set1_ps(SixthsPerDegree)));
+        const __m128 value = byte4(packed, 24);
+        const __m128 chroma = _mm_andnot_ps(gray, _mm_mul_ps(_mm_mul_ps(value, byte4(packed, 16)), _mm_set1_ps(InverseByte)));
+        const __m128i rgb = opaque4(hsvChannel4(5.0f, sixths, value, chroma), hsvChannel4(3.0f, sixths, value, chroma), hsvChannel4(1.0f, sixths, value, chroma));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colors + k), rgb);
+    }
+    hsvToRgbScalar(hsv + k, colors + k, count - k);
+}
+
+/**
+ * @brief SSE2 implementation of ColorSpaces::hslToRgb().
+ */
+PILLUMINATE_TARGET("sse2") void hslToRgbSse2(const ColorSpaces::Hsl *hsl, QRgb *colors, int count) {
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hsl + k));
+        const __m128i hue = _mm_srai_epi32(_mm_slli_epi32(packed, 16), 16);
+        const __m128 gray = _mm_castsi128_ps(_mm_srai_epi32(hue, 31));
+        const __m128 twelfths = _mm_andnot_ps(gray, _mm_mul_ps(_mm_cvtepi32_ps(hue), _mm_set1_ps(TwelfthsPerDegree)));
+        const __m128 lightness = byte4(packed, 24);
+        const __m128 room = _mm_min_ps(lightness, _mm_sub_ps(_mm_set1_ps(255.0f), lightness));
+        const __m128 halfChroma = _mm_andnot_ps(gray, _mm_mul_ps(_mm_mul_ps(byte4(packed, 16), room), _mm_set1_ps(InverseByte)));
+        const __m128i rgb = opaque4(hslChannel4(0.0f, twelfths, lightness, halfChroma), hslChannel4(8.0f, twelfths, lightness, halfChroma), hslChannel4(4.0f, twelfths, lightness, halfChroma));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colors + k), rgb);
+    }
+    hslToRgbScalar(hsl + k, colors + k, count - k);
+}
+
+/**
+ * @brief SSE2 implementation of ColorSpaces::rgbToHsv().
+ * @details Channels are exact in single precision, so the largest and smallest channel are found with float comparisons, which SSE2 has for 32-bit lanes unlike integer ones. Divisions by a zero chroma are avoided by dividing by 1 instead, and their results replaced for the grays.
+ */
+PILLUMINATE_TARGET("sse2") void rgbToHsvSse2(const QRgb *colors, ColorSpaces::Hsv *hsv, int count) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colors + k));
+        const __m128 r = byte4(packed, 16);
+        const __m128 g = byte4(packed, 8);
+        const __m128 b = byte4(packed, 0);
+        const __m128 max = _mm_max_ps(r, _mm_max_ps(g, b));
+        const __m128 chroma = _mm_sub_ps(max, _mm_min_ps(r, _mm_min_ps(g, b)));
+        const __m128 redMax = _mm_cmpeq_ps(max, r);
+        const __m128 greenMax = _mm_andnot_ps(redMax, _mm_cmpeq_ps(max, g));
+        const __m128 difference = select4(redMax, _mm_sub_ps(g, b), select4(greenMax, _mm_sub_ps(b, r), _mm_sub_ps(r, g)));
+        const __m128 base = select4(redMax, _mm_setzero_ps(), select4(greenMax, _mm_set1_ps(2.0f), _mm_set1_ps(4.0f)));
+        __m128 hue = _mm_mul_ps(_mm_add_ps(base, _mm_div_ps(difference, _mm_max_ps(chroma, one))), _mm_set1_ps(60.0f));
+        hue = _mm_add_ps(hue, _mm_and_ps(_mm_cmplt_ps(hue, _mm_setzero_ps()), _mm_set1_ps(360.0f)));
+        const __m128 saturation = _mm_div_ps(_mm_mul_ps(chroma, _mm_set1_ps(255.0f)), _mm_max_ps(max, one));
+        const __m128i gray = _mm_castps_si128(_mm_cmpeq_ps(chroma, _mm_setzero_ps()));
+        const __m128i h = _mm_and_si128(_mm_or_si128(_mm_cvttps_epi32(hue), gray), _mm_set1_epi32(0xffff)); // Grays get all ones, -1 in 16 bits.
+        const __m128i s = _mm_andnot_si128(gray, _mm_cvttps_epi32(_mm_add_ps(saturation, _mm_set1_ps(0.5f))));
+        const __m128i v = _mm_cvttps_epi32(max);
+        const __m128i result = _mm_or_si128(_mm_or_si128(h, _mm_slli_epi32(s, 16)), _mm_slli_epi32(v, 24));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hsv + k), result);
+    }
+    rgbToHsvScalar(colors + k, hsv + k, count - k);
+}
+
+// AVX2: 8 colors per iteration, with native blends.
+
+/**
+ * @brief byte4() on eight lanes.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256 byte8(__m256i packed, int shift) {
+    return _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(packed, shift), _mm256_set1_epi32(255)));
+}
+
+/**
+ * @brief opaque4() on eight lanes.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256i opaque8(__m256 r, __m256 g, __m256 b) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256i ri = _mm256_cvttps_epi32(_mm256_add_ps(r, half));
+    const __m256i gi = _mm256_cvttps_epi32(_mm256_add_ps(g, half));
+    const __m256i bi = _mm256_cvttps_epi32(_mm256_add_ps(b, half));
+    const __m256i rg = _mm256_or_si256(_mm256_slli_epi32(ri, 16), _mm256_slli_epi32(gi, 8));
+    return _mm256_or_si256(_mm256_or_si256(rg, bi), _mm256_set1_epi32(int(0xff000000u)));
+}
+
+/**
+ * @brief hsvChannel() on eight lanes, before rounding.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256 hsvChannel8(float offset, __m256 sixths, __m256 value, __m256 chroma) {
+    const __m256 turn = _mm256_set1_ps(6.0f);
+    __m256 k = _mm256_add_ps(_mm256_set1_ps(offset), sixths);
+    k = _mm256_sub_ps(k, _mm256_and_ps(_mm256_cmp_ps(k, turn, _CMP_GE_OQ), turn));
+    const __m256 weight = _mm256_max_ps(_mm256_setzero_ps(), _mm256_min_ps(_mm256_set1_ps(1.0f), _mm256_min_ps(k, _mm256_sub_ps(_mm256_set1_ps(4.0f), k))));
+    return _mm256_sub_ps(value, _mm256_mul_ps(chroma, weight));
+}
+
+/**
+ * @brief hslChannel() on eight lanes, before rounding.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256 hslChannel8(float offset, __m256 twelfths, __m256 lightness, __m256 halfChroma) {
+    const __m256 turn = _mm256_set1_ps(12.0f);
+    __m256 k = _mm256_add_ps(_mm256_set1_ps(offset), twelfths);
+    k = _mm256_sub_ps(k, _mm256_and_ps(_mm256_cmp_ps(k, turn, _CMP_GE_OQ), turn));
+    const __m256 distance = _mm256_min_ps(_mm256_sub_ps(k, _mm256_set1_ps(3.0f)), _mm256_sub_ps(_mm256_set1_ps(9.0f), k));
+    const __m256 weight = _mm256_max_ps(_mm256_set1_ps(-1.0f), _mm256_min_ps(_mm256_set1_ps(1.0f), distance));
+    return _mm256_sub_ps(lightness, _mm256_mul_ps(halfChroma, weight));
+}
+
+/**
+ * @brief AVX2 implementation of ColorSpaces::hsvToRgb().
+ */
+PILLUMINATE_TARGET("avx2") void hsvToRgbAvx2(const ColorSpaces::Hsv *hsv, QRgb *colors, int count) {
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hsv + k));
+        const __m256i hue = _mm256_srai_epi32(_mm256_slli_epi32(packed, 16), 16);
+        const __m256 gray = _mm256_castsi256_ps(_mm256_srai_epi32(hue, 31));
+        const __m256 sixths = _mm256_andnot_ps(gray, _mm256_mul_ps(_mm256_cvtepi32_ps(hue), _mm256_set1_ps(SixthsPerDegree)));
+        const __m256 value = byte8(packed, 24);
+        const __m256 chroma = _mm256_andnot_ps(gray, _mm256_mul_ps(_mm256_mul_ps(value, byte8(packed, 16)), _mm256_set1_ps(InverseByte)));
+        const __m256i rgb = opaque8(hsvChannel8(5.0f, sixths, value, chroma), hsvChannel8(3.0f, sixths, value, chroma), hsvChannel8(1.0f, sixths, value, chroma));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colors + k), rgb);
+    }
+    hsvToRgbScalar(hsv + k, colors + k, count - k);
+}
+
+/**
+ * @brief AVX2 implementation of ColorSpaces::hslToRgb().
+ */
+PILLUMINATE_TARGET("avx2") void hslToRgbAvx2(const ColorSpaces::Hsl *hsl, QRgb *colors, int count) {
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hsl + k));
+        const __m256i hue = _mm256_srai_epi32(_mm256_slli_epi32(packed, 16), 16);
+        const __m256 gray = _mm256_castsi256_ps(_mm256_srai_epi32(hue, 31));
+        const __m256 twelfths = _mm256_andnot_ps(gray, _mm256_mul_ps(_mm256_cvtepi32_ps(hue), _mm256_set1_ps(TwelfthsPerDegree)));
+        const __m256 lightness = byte8(packed, 24);
+        const __m256 room = _mm256_min_ps(lightness, _mm256_sub_ps(_mm256_set1_ps(255.0f), lightness));
+        const __m256 halfChroma = _mm256_andnot_ps(gray, _mm256_mul_ps(_mm256_mul_ps(byte8(packed, 16), room), _mm256_set1_ps(InverseByte)));
+        const __m256i rgb = opaque8(hslChannel8(0.0f, twelfths, lightness, halfChroma), hslChannel8(8.0f, twelfths, lightness, halfChroma), hslChannel8(4.0f, twelfths, lightness, halfChroma));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colors + k), rgb);
+    }
+    hslToRgbScalar(hsl + k, colors + k, count - k);
+}
+
+/**
+ * @brief AVX2 implementation of ColorSpaces::rgbToHsv().
+ */
+PILLUMINATE_TARGET("avx2") void rgbToHsvAvx2(const QRgb *colors, ColorSpaces::Hsv *hsv, int count) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(colors + k));
+        const __m256 r = byte8(packed, 16);
+        const __m256 g = byte8(packed, 8);
+        const __m256 b = byte8(packed, 0);
+        const __m256 max = _mm256_max_ps(r, _mm256_max_ps(g, b));
+        const __m256 chroma = _mm256_sub_ps(max, _mm256_min_ps(r, _mm256_min_ps(g, b)));
+        const __m256 redMax = _mm256_cmp_ps(max, r, _CMP_EQ_OQ);
+        const __m256 greenMax = _mm256_cmp_ps(max, g, _CMP_EQ_OQ);
+        const __m256 difference = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_sub_ps(r, g), _mm256_sub_ps(b, r), greenMax), _mm256_sub_ps(g, b), redMax);
+        const __m256 base = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_set1_ps(4.0f), _mm256_set1_ps(2.0f), greenMax), zero, redMax);
+        __m256 hue = _mm256_mul_ps(_mm256_add_ps(base, _mm256_div_ps(difference, _mm256_max_ps(chroma, one))), _mm256_set1_ps(60.0f));
+        hue = _mm256_add_ps(hue, _mm256_and_ps(_mm256_cmp_ps(hue, zero, _CMP_LT_OQ), _mm256_set1_ps(360.0f)));
+        const __m256 saturation = _mm256_div_ps(_mm256_mul_ps(chroma, _mm256_set1_ps(255.0f)), _mm256_max_ps(max, one));
+        const __m256i gray = _mm256_castps_si256(_mm256_cmp_ps(chroma, zero, _CMP_EQ_OQ));
+        const __m256i h = _mm256_and_si256(_mm256_or_si256(_mm256_cvttps_epi32(hue), gray), _mm256_set1_epi32(0xffff));
+        const __m256i s = _mm256_andnot_si256(gray, _mm256_cvttps_epi32(_mm256_add_ps(saturation, _mm256_set1_ps(0.5f))));
+        const __m256i v = _mm256_cvttps_epi32(max);
+        const __m256i result = _mm256_or_si256(_mm256_or_si256(h, _mm256_slli_epi32(s, 16)), _mm256_slli_epi32(v, 24));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(hsv + k), result);
+    }
+    rgbToHsvScalar(colors + k, hsv + k, count - k);
+}
+
+#endif
+
+}
+
+/**
+ * @brief Converts HSV colors to RGB.
+ * @param hsv The colors to convert.
+ * @param colors The converted colors to write.
+ * @param count The number of colors.
+ */
+void ColorSpaces::hsvToRgb(const Hsv *hsv, QRgb *colors, int count) {
+#ifdef PILLUMINATE_X86_SIMD
+    const CpuFeatures::Level level = CpuFeatures::level();
+    if (level == CpuFeatures::Avx2) {hsvToRgbAvx2(hsv, colors, count); return;}
+    if (level == CpuFeatures::Sse2) {hsvToRgbSse2(hsv, colors, count); return;}
+#endif
+    hsvToRgbScalar(hsv, colors, count);
+}
+
+/**
+ * @brief Converts HSL colors to RGB.
+ * @param hsl The colors to convert.
+ * @param colors The converted colors to write.
+ * @param count The number of colors.
+ */
+void ColorSpaces::hslToRgb(const Hsl *hsl, QRgb *colors, int count) {
+#ifdef PILLUMINATE_X86_SIMD
+    const CpuFeatures::Level level = CpuFeatures::level();
+    if (level == CpuFeatures::Avx2) {hslToRgbAvx2(hsl, colors, count); return;}
+    if (level == CpuFeatures::Sse2) {hslToRgbSse2(hsl, colors, count); return;}
+#endif
+    hslToRgbScalar(hsl, colors, count);
+}
+
+/**
+ * @brief Converts RGB colors to HSV.
+ * @param colors The colors to convert.
+ * @param hsv The converted colors to write.
+ * @param count The number of colors.
+ */
+void ColorSpaces::rgbToHsv(const QRgb *colors, Hsv *hsv, int count) {
+#ifdef PILLUMINATE_X86_SIMD
+    const CpuFeatures::Level level = CpuFeatures::level();
+    if (level == CpuFeatures::Avx2) {rgbToHsvAvx2(colors, hsv, count); return;}
+    if (level == CpuFeatures::Sse2) {rgbToHsvSse2(colors, hsv, count); return;}
+#endif
+    rgbToHsvScalar(colors, hsv, count);
+}
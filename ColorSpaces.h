@@ -0,0 +1,75 @@
+/**
+ * @file ColorSpaces.h
+ * @brief Defines the ColorSpaces class, which converts arrays of colors between RGB, HSV and HSL.
+ * @details This header file contains the declaration of the ColorSpaces class and of the packed HSV and HSL colors it works on. The conversions follow the conventions of QColor, so hues from QColor::hsvHue() or QColor::hslHue() can be fed to them directly, but they convert whole arrays in one pass instead of one QColor at a time.
+ * @author Group 3
+ */
+
+#ifndef COLORSPACES_H
+#define COLORSPACES_H
+
+// Including necessary modules.
+#include <QRgb>
+#include <QtGlobal>
+
+/**
+ * @class ColorSpaces
+ * @brief Batch conversions between RGB, HSV and HSL.
+ * @details Each conversion has an AVX2, an SSE2 and a scalar implementation selected by CpuFeatures. They compute in single precision, performing the same operations in the same order, so all of them give bit-identical results; these are within one step of what QColor gives for the same color, QColor rounding through 16-bit channels. RGB colors are packed ARGB32; the alpha of converted colors is ignored and the RGB colors written are always opaque.
+ * @author Group 3
+ */
+class ColorSpaces {
+
+public:
+
+    /**
+     * @brief A color in the HSV model, packed into 32 bits.
+     */
+    struct Hsv {
+        qint16 hue; ///< Hue in degrees, from 0 to 359, or -1 for a gray.
+        quint8 saturation; ///< Saturation, from 0 to 255.
+        quint8 value; ///< Value, from 0 to 255.
+    };
+
+    /**
+     * @brief A color in the HSL model, packed into 32 bits.
+     */
+    struct Hsl {
+        qint16 hue; ///< Hue in degrees, from 0 to 359, or -1 for a gray.
+        quint8 saturation; ///< Saturation, from 0 to 255.
+        quint8 lightness; ///< Lightness, from 0 to 255.
+    };
+
+    /**
+     * @brief Converts HSV colors to RGB.
+     * @details Matches QColor::fromHsv().
+     * @param hsv The colors to convert.
+     * @param colors The converted colors to write.
+     * @param count The number of colors.
+     */
+    static void hsvToRgb(const Hsv *hsv, QRgb *colors, int count);
+
+    /**
+     * @brief Converts HSL colors to RGB.
+     * @details Matches QColor::fromHsl().
+     * @param hsl The colors to convert.
+     * @param colors The converted colors to write.
+     * @param count The number of colors.
+     */
+    static void hslToRgb(const Hsl *hsl, QRgb *colors, int count);
+
+    /**
+     * @brief Converts RGB colors to HSV.
+     * @details Matches QColor::hsvHue(), QColor::hsvSaturation() and QColor::value(); like QColor, grays get a hue of -1 and fractional hues are truncated.
+     * @param colors The colors to convert.
+     * @param hsv The converted colors to write.
+     * @param count The number of colors.
+     */
+    static void rgbToHsv(const QRgb *colors, Hsv *hsv, int count);
+
+};
+
+// The vector implementations load four packed colors per 128-bit register.
+Q_STATIC_ASSERT(sizeof(ColorSpaces::Hsv) == 4 && sizeof(ColorSpaces::Hsl) == 4);
+
+#endif // COLORSPACES_H
@@ -0,0 +1,404 @@
+/**
+ * @file CommandInterface.cpp
+ * @brief Implementation of the CommandInterface class.
+ * @details This file contains the implementation of the CommandInterface class: parsing of the command lines, the translation of the controller's results into replies, and the two command sources, standard input and a local socket.
+ * @see CommandInterface.h for the declaration of the CommandInterface class.
+ * @author Group 3
+ */
+
+#include "include/interfaces/CommandInterface.h"
+#include "include/models/Effects.h"
+#include "include/utils/Trace.h"
+
+// Including necessary modules.
+#include <QCoreApplication>
+#include <QList>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QThread>
+#include <cstdio>
+
+namespace {
+
+/**
+ * @brief Builds an error reply.
+ * @param message The reason the command failed.
+ * @return The reply line.
+ */
+QByteArray error(const char *message) {
+    return QByteArray("error: ") + message + '\n';
+}
+
+/**
+ * @brief Builds the reply of a successful command.
+ * @param details Text following "ok", if any.
+ * @return The reply line.
+ */
+QByteArray success(const QByteArray &details = QByteArray()) {
+    return details.isEmpty() ? QByteArray("ok\n") : "ok " + details + '\n';
+}
+
+const char *const HelpText = "commands: add [count], remove <n|all|off>, on <n|all>, off <n|all>, color <n|all> <color>, recolor <color> <color>, effect <name|off> [color] [color] [ms] [leds], blink <n|all> <ms>, duration <n|all> <seconds>, status [n], trace start, trace stop <file>, help, quit";
+
+}
+
+/**
+ * @brief Constructs a CommandInterface.
+ * @details The controller's schedulers need no view: the blink phases and expired LEDs are kept in the store, where status queries read them. There is no view to hand the changed LEDs to either, so their dirty flags are cleared right away.
+ * @param parent The parent object.
+ */
+CommandInterface::CommandInterface(QObject *parent) : QObject(parent), controller(new LedController(this)) {
+    connect(controller, &LedController::ledsChanged, controller, &LedController::clearDirty);
+}
+
+/**
+ * @brief Destroys the CommandInterface.
+ * @details The reader thread is blocked on standard input until it reads "quit" or the input ends, both of which also quit the application, so waiting for it does not hang.
+ */
+CommandInterface::~CommandInterface() {
+    if (inputReader) {
+        inputReader->wait();
+        delete inputReader;
+    }
+}
+
+/**
+ * @brief Reads commands from standard input.
+ * @details Reading blocks, so it happens on a thread of its own; every line is handed to the interface's thread through its event loop, which keeps all access to the store on one thread.
+ */
+void CommandInterface::readStandardInput() {
+
+    if (inputReader) {return;}
+
+    inputReader = QThread::create([this]() {
+        char buffer[4096];
+        while (std::fgets(buffer, sizeof(buffer), stdin)) {
+            const QByteArray line = QByteArray(buffer).trimmed();
+            QMetaObject::invokeMethod(this, [this, line]() {
+                const QByteArray reply = execute(line);
+                std::fwrite(reply.constData(), 1, size_t(reply.size()), stdout);
+                std::fflush(stdout);
+            }, Qt::QueuedConnection);
+            if (line.simplified().toLower() == "quit") {return;} // The command itself quits the application.
+        }
+        QMetaObject::invokeMethod(QCoreApplication::instance(), &QCoreApplication::quit, Qt::QueuedConnection); // End of the input.
+    });
+    inputReader->start();
+
+}
+
+/**
+ * @brief Accepts commands from clients of a local socket.
+ * @details A socket left behind by an instance that did not shut down cleanly is removed first.
+ * @param name The name of the local socket.
+ * @return True if the socket is listening.
+ */
+bool CommandInterface::listen(const QString &name) {
+    if (!server) {
+        server = new QLocalServer(this);
+        connect(server, &QLocalServer::newConnection, this, &CommandInterface::acceptClients);
+    }
+    QLocalServer::removeServer(name);
+    return server->listen(name);
+}
+
+/**
+ * @brief Accepts pending clients of the local socket.
+ * @details Every complete line a client sends is executed and answered on the same connection. Clients are deleted when they disconnect.
+ */
+void CommandInterface::acceptClients() {
+    while (QLocalSocket *client = server->nextPendingConnection()) {
+        connect(client, &QLocalSocket::disconnected, client, &QObject::deleteLater);
+        connect(client, &QLocalSocket::readyRead, this, [this, client]() {
+            while (client->canReadLine()) {client->write(execute(client->readLine().trimmed()));}
+        });
+    }
+}
+
+/**
+ * @brief Executes one command.
+ * @details Words are separated by whitespace and commands are case-insensitive.
+ * @param line The command.
+ * @return The reply.
+ */
+QByteArray CommandInterface::execute(const QByteArray &line) {
+
+    Trace::Span span("CommandInterface::execute");
+
+    const QList<QByteArray> words = line.simplified().split(' ');
+    const QByteArray command = words.at(0).toLower();
+    const QByteArray argument = words.value(1).toLower();
+    bool ok = true;
+
+    if (command.isEmpty()) {return QByteArray();} // Ignoring blank lines.
+
+    if (command == "add") {
+        const int count = words.size() > 1 ? argument.toInt(&ok) : 1;
+        if (!ok || count <= 0) {return error("expected a positive number of LEDs");}
+        return add(count);
+    }
+    if (command == "remove") {return remove(argument);}
+    if (command == "on" || command == "off") {return turn(argument, command == "on");}
+    if (command == "color") {
+        const QColor color = QColor::fromString(words.value(2));
+        if (!color.isValid()) {return error("expected a color such as #ff8000 or red");}
+        return setColor(argument, color);
+    }
+    if (command == "recolor") {
+        const QColor from = QColor::fromString(words.value(1));
+        const QColor to = QColor::fromString(words.value(2));
+        if (!from.isValid() || !to.isValid() || from.alpha() == 0 || to.alpha() == 0) {return error("expected two colors that are not transparent");}
+        return recolor(from.rgba(), to.rgba());
+    }
+    if (command == "blink") {
+        const int speed = words.value(2).toInt(&ok);
+        if (!ok || speed < 0) {return error("expected a blinking speed in milliseconds");}
+        return setBlinkSpeed(argument, speed);
+    }
+    if (command == "duration") {
+        const int seconds = words.value(2).toInt(&ok);
+        if (!ok || seconds < 0) {return error("expected a duration in seconds");}
+        return setDuration(argument, seconds);
+    }
+    if (command == "effect") {return startEffect(words);}
+    if (command == "status") {return status(argument);}
+    if (command == "trace" && argument == "start") {
+        Trace::start();
+        return success();
+    }
+    if (command == "trace" && argument == "stop") {
+        Trace::stop();
+        if (words.size() < 3) {return error("expected a file to write the trace to");}
+        if (!Trace::write(QString::fromLocal8Bit(words.at(2)))) {return error("could not write the trace");}
+        return success();
+    }
+    if (command == "help") {return success(HelpText);}
+    if (command == "quit") {
+        QMetaObject::invokeMethod(QCoreApplication::instance(), &QCoreApplication::quit, Qt::QueuedConnection); // Letting the reply go out first.
+        return success();
+    }
+
+    return error("unknown command, type help for the list of commands");
+
+}
+
+/**
+ * @brief Finds the LED addressed by a display number.
+ * @param argument The display number.
+ * @return The slot of the LED, or -1 if there is no such LED.
+ */
+int CommandInterface::slotAt(const QByteArray &argument) const {
+    const LedStore &store = controller->ledStore();
+    bool ok;
+    const int number = argument.toInt(&ok);
+    if (!ok || number < 1 || number > store.size()) {return -1;}
+    return store.displayOrder().at(number - 1);
+}
+
+/**
+ * @brief Adds LEDs at the end of the display order.
+ * @param count The number of LEDs to add.
+ * @return The reply, with the new number of LEDs.
+ */
+QByteArray CommandInterface::add(int count) {
+    if (controller->addLeds(count) == LedController::Full) {return error("not enough room for that many LEDs");}
+    return success(QByteArray::number(controller->ledStore().size()));
+}
+
+/**
+ * @brief Removes LEDs.
+ * @param argument A display number, "all" or "off".
+ * @return The reply, with the remaining number of LEDs.
+ */
+QByteArray CommandInterface::remove(const QByteArray &argument) {
+
+    if (argument == "all") {
+        if (controller->removeAll() == LedController::NoLeds) {return error("no LEDs to remove");}
+    } else if (argument == "off") {
+        switch (controller->removeOff()) {
+        case LedController::NoLeds: return error("no LEDs to remove");
+        case LedController::NoneOff: return error("no LEDs are off");
+        default: break;
+        }
+    } else {
+        const int slot = slotAt(argument);
+        if (slot < 0) {return error("no such LED");}
+        controller->remove(slot);
+    }
+
+    return success(QByteArray::number(controller->ledStore().size()));
+
+}
+
+/**
+ * @brief Turns LEDs on or off.
+ * @details An LED already in the requested state is left alone; for "all", this is reported as an error if it holds for every LED, matching the warnings of the graphical interface.
+ * @param argument A display number or "all".
+ * @param state True to turn the LEDs on, false to turn them off.
+ * @return The reply, with the number of LEDs that changed.
+ */
+QByteArray CommandInterface::turn(const QByteArray &argument, bool state) {
+
+    if (argument == "all") {
+        const int before = controller->ledStore().onCount();
+        switch (controller->turnAll(state)) {
+        case LedController::NoLeds: return error("no LEDs to turn on or off");
+        case LedController::AllOn: return error("all LEDs are already on");
+        case LedController::AllOff: return error("all LEDs are already off");
+        default: return success(QByteArray::number(qAbs(controller->ledStore().onCount() - before)));
+        }
+    }
+
+    const int slot = slotAt(argument);
+    if (slot < 0) {return error("no such LED");}
+    return success(controller->turn(slot, state) ? "1" : "0");
+
+}
+
+/**
+ * @brief Changes the color of LEDs.
+ * @param argument A display number or "all".
+ * @param color The new color.
+ * @return The reply, with the number of LEDs that changed.
+ */
+QByteArray CommandInterface::setColor(const QByteArray &argument, const QColor &color) {
+
+    if (argument == "all") {
+        switch (controller->checkOnLeds(LedController::ColorChange)) {
+        case LedController::NoLeds: return error("no LEDs to change color");
+        case LedController::NoneOn: return error("at least one LED must be on to change colors");
+        default: return success(QByteArray::number(controller->setOnColor(color)));
+        }
+    }
+
+    const int slot = slotAt(argument);
+    if (slot < 0) {return error("no such LED");}
+    controller->setColor(slot, color);
+    return success("1");
+
+}
+
+/**
+ * @brief Gives every LED of one color another color.
+ * @param from The color to replace.
+ * @param to The new color.
+ * @return The reply, with the number of LEDs that changed.
+ */
+QByteArray CommandInterface::recolor(QRgb from, QRgb to) {
+    return success(QByteArray::number(controller->recolor(from, to)));
+}
+
+/**
+ * @brief Sets the blink speed of LEDs.
+ * @param argument A display number or "all".
+ * @param speed The blinking speed in milliseconds.
+ * @return The reply, with the number of LEDs that changed.
+ */
+QByteArray CommandInterface::setBlinkSpeed(const QByteArray &argument, int speed) {
+
+    if (argument == "all") {
+        switch (controller->checkOnLeds(LedController::BlinkSpeedChange)) {
+        case LedController::NoLeds: return error("no LEDs to set blinking speed");
+        case LedController::NoneOn: return error("at least one LED must be on to set blinking speed");
+        default: return success(QByteArray::number(controller->setOnBlinkSpeed(speed)));
+        }
+    }
+
+    const int slot = slotAt(argument);
+    if (slot < 0) {return error("no such LED");}
+    controller->setBlinkSpeed(slot, speed);
+    return success("1");
+
+}
+
+/**
+ * @brief Sets how long LEDs stay on.
+ * @details A duration of 0 leaves pending deadlines untouched, as in the graphical interface.
+ * @param argument A display number or "all".
+ * @param seconds The duration in seconds.
+ * @return The reply, with the number of LEDs that changed.
+ */
+QByteArray CommandInterface::setDuration(const QByteArray &argument, int seconds) {
+
+    if (argument == "all") {
+        switch (controller->checkOnLeds(LedController::DurationChange)) {
+        case LedController::NoLeds: return error("no LEDs to set duration");
+        case LedController::NoneOn: return error("at least one LED must be on to set duration");
+        default: return success(QByteArray::number(controller->setOnDuration(seconds)));
+        }
+    }
+
+    const int slot = slotAt(argument);
+    if (slot < 0) {return error("no such LED");}
+    controller->setDuration(slot, seconds);
+    return success(seconds > 0 ? "1" : "0");
+
+}
+
+/**
+ * @brief Starts or stops an effect.
+ * @details Parameters that are not given keep the defaults of Effects::Parameters.
+ * @param words The words of the command.
+ * @return The reply.
+ */
+QByteArray CommandInterface::startEffect(const QList<QByteArray> &words) {
+
+    const QString name = QString::fromLatin1(words.value(1).toLower());
+    if (name == "off") {
+        controller->setEffect(nullptr);
+        return success();
+    }
+
+    Effects::Parameters parameters;
+    bool ok = true;
+    if (words.size() > 2) {
+        const QColor color = QColor::fromString(words.at(2));
+        if (!color.isValid()) {return error("expected a color such as #ff8000 or red");}
+        parameters.color = color.rgb();
+    }
+    if (words.size() > 3) {
+        const QColor color = QColor::fromString(words.at(3));
+        if (!color.isValid()) {return error("expected a color such as #ff8000 or red");}
+        parameters.secondColor = color.rgb();
+    }
+    if (words.size() > 4) {
+        parameters.period = words.at(4).toInt(&ok);
+        if (!ok || parameters.period <= 0) {return error("expected a period in milliseconds");}
+    }
+    if (words.size() > 5) {
+        parameters.length = words.at(5).toInt(&ok);
+        if (!ok || parameters.length <= 0) {return error("expected a number of LEDs per cycle");}
+    }
+
+    const QSharedPointer<const Effect> effect = Effects::create(name, parameters);
+    if (!effect) {return error(("expected one of " + Effects::names().join(", ") + " or off").toLatin1().constData());}
+    controller->setEffect(effect);
+    return success();
+
+}
+
+/**
+ * @brief Describes the whole model or one LED.
+ * @details For the whole model, reports the number of LEDs, how many are on, blinking and waiting for their duration to end, and the number of palette colors, 0 meaning that colors are stored per LED, and the running effect. For one LED, reports its ID, state, color, blink speed and remaining duration in milliseconds, -1 meaning none.
+ * @param argument A display number, or empty for the whole model.
+ * @return The reply.
+ */
+QByteArray CommandInterface::status(const QByteArray &argument) const {
+
+    const LedStore &store = controller->ledStore();
+
+    if (argument.isEmpty()) { // The store keeps these counts, so this is O(1).
+        const QSharedPointer<const Effect> effect = controller->effect();
+        return success(QString("leds=%1 on=%2 blinking=%3 timed=%4 palette=%5 effect=%6").arg(store.size()).arg(store.onCount()).arg(store.blinkingCount()).arg(store.timedCount()).arg(store.paletteSize())
+                       .arg(effect ? effect->name() : QString("none")).toLatin1());
+    }
+
+    const int slot = slotAt(argument);
+    if (slot < 0) {return error("no such LED");}
+    const qint64 deadline = store.offDeadline(slot);
+    const qint64 remaining = deadline < 0 ? -1 : qMax<qint64>(0, deadline - store.now());
+    return success(QString("led=%1 id=%2 on=%3 lit=%4 color=%5 blink=%6 duration=%7")
+                   .arg(argument.toInt()).arg(store.handleOf(slot)).arg(store.isOn(slot) ? 1 : 0).arg(store.blinkPhase(slot) ? 1 : 0)
+                   .arg(store.color(slot).name()).arg(store.blinkPeriod(slot)).arg(remaining).toLatin1());
+
+}
@@ -0,0 +1,165 @@
+/**
+ * @file CommandInterface.h
+ * @brief Defines the CommandInterface class, which drives the LED model from text commands without any widgets.
+ * @details This header file contains the declaration of the CommandInterface class, used when the application is started with --headless. It owns a LedController, reads one command per line from standard input or from clients of a local socket, and answers each command with one line. It only needs a QCoreApplication event loop, and keeps no per-LED objects, so an LED costs no more than its entries in the store's arrays.
+ * @author Group 3
+ */
+
+#ifndef COMMANDINTERFACE_H
+#define COMMANDINTERFACE_H
+
+#include "include/models/LedController.h"
+
+// Including necessary modules.
+#include <QByteArray>
+#include <QColor>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+class QLocalServer;
+class QThread;
+
+/**
+ * @class CommandInterface
+ * @brief Line-based command interface to the LED model.
+ * @details Commands address LEDs by their display number, counted from 1 as in the log, or by "all". The operations are carried out by the same LedController as in the graphical interface, so they follow the same rules: colors, blink speeds and durations are applied to the LEDs that are on. Every command is answered with a line starting with "ok" or "error:". Type "help" for the list of commands.
+ * @author Group 3
+ */
+class CommandInterface : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructor for CommandInterface.
+     * @details Creates the controller. Nothing is read until listen() or readStandardInput() is called.
+     * @param parent The parent object.
+     */
+    explicit CommandInterface(QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor for CommandInterface.
+     * @details Waits for the standard input reader, which stops by itself after "quit" or at the end of the input.
+     */
+    virtual ~CommandInterface() override;
+
+    /**
+     * @brief Reads commands from standard input.
+     * @details Lines are read on a separate thread and executed on the thread of the interface; replies go to standard output. The application quits at the end of the input.
+     */
+    void readStandardInput();
+
+    /**
+     * @brief Accepts commands from clients of a local socket.
+     * @details Each client may send any number of lines and receives the replies on the same connection.
+     * @param name The name of the local socket.
+     * @return bool True if the socket is listening, false if it could not be created.
+     */
+    bool listen(const QString &name);
+
+    /**
+     * @brief Executes one command.
+     * @param line The command, without its line break.
+     * @return QByteArray The reply, ending with a line break, or nothing for a blank line.
+     */
+    QByteArray execute(const QByteArray &line);
+
+private slots:
+
+    /**
+     * @brief Accepts pending clients of the local socket.
+     */
+    void acceptClients();
+
+private:
+
+    LedController *controller; // The LED model and the operations on it.
+    QLocalServer *server = nullptr; // Local socket server, if listening.
+    QThread *inputReader = nullptr; // Thread reading standard input, if started.
+
+    /**
+     * @brief Finds the LED addressed by a display number.
+     * @param argument The display number, counted from 1.
+     * @return int The slot of the LED, or -1 if the argument is not the number of an existing LED.
+     */
+    int slotAt(const QByteArray &argument) const;
+
+    /**
+     * @brief Adds LEDs at the end of the display order.
+     * @param count The number of LEDs to add.
+     * @return QByteArray The reply.
+     */
+    QByteArray add(int count);
+
+    /**
+     * @brief Removes LEDs.
+     * @param argument A display number, "all" or "off".
+     * @return QByteArray The reply.
+     */
+    QByteArray remove(const QByteArray &argument);
+
+    /**
+     * @brief Turns LEDs on or off.
+     * @details Turning an LED on makes it white and cancels its duration; turning it off also stops its blinking.
+     * @param argument A display number or "all".
+     * @param state True to turn the LEDs on, false to turn them off.
+     * @return QByteArray The reply.
+     */
+    QByteArray turn(const QByteArray &argument, bool state);
+
+    /**
+     * @brief Changes the color of LEDs.
+     * @details A transparent color turns an LED off, any other color turns it on. With "all", only the LEDs that are on change.
+     * @param argument A display number or "all".
+     * @param color The new color.
+     * @return QByteArray The reply.
+     */
+    QByteArray setColor(const QByteArray &argument, const QColor &color);
+
+    /**
+     * @brief Gives every LED of one color another color.
+     * @details The on/off state is not touched, so neither color may be transparent.
+     * @param from The color to replace.
+     * @param to The new color.
+     * @return QByteArray The reply.
+     */
+    QByteArray recolor(QRgb from, QRgb to);
+
+    /**
+     * @brief Sets the blink speed of LEDs.
+     * @details With "all", only the LEDs that are on change.
+     * @param argument A display number or "all".
+     * @param speed The blinking speed in milliseconds, 0 to stop blinking.
+     * @return QByteArray The reply.
+     */
+    QByteArray setBlinkSpeed(const QByteArray &argument, int speed);
+
+    /**
+     * @brief Sets how long LEDs stay on.
+     * @details With "all", only the LEDs that are on change.
+     * @param argument A display number or "all".
+     * @param seconds The duration in seconds.
+     * @return QByteArray The reply.
+     */
+    QByteArray setDuration(const QByteArray &argument, int seconds);
+
+    /**
+     * @brief Starts or stops an effect.
+     * @details The words after the name are optional and taken in order: the main color, the second color, the period in milliseconds and the number of LEDs per cycle.
+     * @param words The words of the command, the second one being the name of the effect or "off".
+     * @return QByteArray The reply.
+     */
+    QByteArray startEffect(const QList<QByteArray> &words);
+
+    /**
+     * @brief Describes the whole model or one LED.
+     * @param argument A display number, or empty for the whole model.
+     * @return QByteArray The reply.
+     */
+    QByteArray status(const QByteArray &argument) const;
+
+};
+
+#endif // COMMANDINTERFACE_H
@@ -0,0 +1,74 @@
+/**
+ * @file CpuFeatures.cpp
+ * @brief Implementation of the CpuFeatures class.
+ * @details This file contains the implementation of the CpuFeatures class. Detection uses the compiler's CPUID builtins, which also check that the operating system saves the AVX registers.
+ * @see CpuFeatures.h for the declaration of the CpuFeatures class.
+ * @author Group 3
+ */
+
+#include "include/utils/CpuFeatures.h"
+
+// Including necessary modules.
+#include <QAtomicInt>
+
+namespace {
+
+QAtomicInt selected(-1); // Level the kernels run with, -1 until first used.
+
+/**
+ * @brief Asks the processor which instruction sets it supports.
+ * @return The best level.
+ */
+CpuFeatures::Level detect() {
+#ifdef PILLUMINATE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {return CpuFeatures::Avx2;}
+    if (__builtin_cpu_supports("sse2")) {return CpuFeatures::Sse2;}
+#endif
+    return CpuFeatures::Scalar;
+}
+
+}
+
+/**
+ * @brief Gets the level the kernels run with.
+ * @return The level.
+ */
+CpuFeatures::Level CpuFeatures::level() {
+    int current = selected.loadRelaxed();
+    if (current < 0) {
+        current = supportedLevel();
+        selected.testAndSetRelaxed(-1, current); // Keeping a level set meanwhile.
+        current = selected.loadRelaxed();
+    }
+    return Level(current);
+}
+
+/**
+ * @brief Gets the best level the processor supports.
+ * @details The result cannot change while the process runs, so it is computed once.
+ * @return The supported level.
+ */
+CpuFeatures::Level CpuFeatures::supportedLevel() {
+    static const Level supported = detect();
+    return supported;
+}
+
+/**
+ * @brief Sets the level the kernels run with.
+ * @param level The level.
+ */
+void CpuFeatures::setLevel(Level level) {
+    selected.storeRelaxed(qMin(level, supportedLevel()));
+}
+
+/**
+ * @brief Gets the name of a level.
+ * @param level The level.
+ * @return The name.
+ */
+const char *CpuFeatures::name(Level level) {
+    if (level == Avx2) {return "avx2";}
+    if (level == Sse2) {return "sse2";}
+    return "scalar";
+}
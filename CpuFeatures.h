@@ -0,0 +1,67 @@
+/**
+ * @file CpuFeatures.h
+ * @brief Defines the CpuFeatures class, which picks the instruction set used by the vectorized kernels.
+ * @details This header file contains the declaration of the CpuFeatures class and the macros guarding the SIMD code paths. Kernels are compiled for every instruction set the compiler can target, independently of the flags the rest of the application is built with, and the path to run is chosen at runtime from what the processor supports, so one binary uses AVX2 where it is available and still runs everywhere else.
+ * @author Group 3
+ */
+
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+// Including necessary modules.
+#include <QtGlobal>
+
+// The SSE2 and AVX2 paths need per-function target attributes, which GCC and Clang provide; other compilers and processors use the scalar path.
+#if defined(Q_PROCESSOR_X86) && defined(__GNUC__)
+#define PILLUMINATE_X86_SIMD
+#define PILLUMINATE_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+/**
+ * @class CpuFeatures
+ * @brief Detects the best supported kernel level once and lets it be lowered.
+ * @details Every kernel has a scalar implementation producing exactly the same results as its vector implementations, so the level only changes the speed. Lowering the level is meant for the benchmark and for checking the vector paths against the scalar one.
+ * @author Group 3
+ */
+class CpuFeatures {
+
+public:
+
+    /**
+     * @brief Instruction sets a kernel can be run with, from least to most capable.
+     */
+    enum Level {
+        Scalar, ///< Plain C++, left to the compiler.
+        Sse2, ///< 128-bit integer vectors.
+        Avx2 ///< 256-bit integer vectors.
+    };
+
+    /**
+     * @brief Gets the level the kernels run with.
+     * @return Level The supported level, or the lower one set with setLevel().
+     */
+    static Level level();
+
+    /**
+     * @brief Gets the best level the processor supports.
+     * @details Detected on the first call.
+     * @return Level The supported level.
+     */
+    static Level supportedLevel();
+
+    /**
+     * @brief Sets the level the kernels run with.
+     * @param level The level, capped at supportedLevel().
+     */
+    static void setLevel(Level level);
+
+    /**
+     * @brief Gets the name of a level.
+     * @param level The level.
+     * @return const char* The name, such as "avx2".
+     */
+    static const char *name(Level level);
+
+};
+
+#endif // CPUFEATURES_H
@@ -0,0 +1,72 @@
+/**
+ * @file DurationScheduler.cpp
+ * @brief Implementation of the DurationScheduler class.
+ * @details This file contains the implementation of the DurationScheduler class, including the batched expiry pass that switches off every LED whose duration ran out.
+ * @see DurationScheduler.h for the declaration of the DurationScheduler class.
+ * @author Group 3
+ */
+
+#include "include/models/DurationScheduler.h"
+#include "include/models/BlinkScheduler.h"
+#include "include/utils/EventLog.h"
+#include "include/utils/Trace.h"
+
+// Including necessary modules.
+#include <QScopedPointer>
+
+/**
+ * @brief Constructs a DurationScheduler.
+ * @details Uses a precise single-shot timer, since the wakeup is aimed at a specific deadline.
+ * @param store The store holding the off-deadlines.
+ * @param parent The parent object.
+ */
+DurationScheduler::DurationScheduler(LedStore *store, QObject *parent) : QObject(parent), store(store), wakeTimer(new QTimer(this)) {
+    wakeTimer->setSingleShot(true);
+    wakeTimer->setTimerType(Qt::PreciseTimer);
+    connect(wakeTimer, &QTimer::timeout, this, &DurationScheduler::expire);
+}
+
+/**
+ * @brief Aims the wakeup timer at the nearest pending off-deadline.
+ */
+void DurationScheduler::reschedule() {
+    const qint64 next = store->nextOffDeadline();
+    if (next < 0) {
+        wakeTimer->stop(); // No LED has a pending duration.
+        return;
+    }
+    wakeTimer->start(int(qMax<qint64>(0, next - store->now())));
+}
+
+/**
+ * @brief Switches off every LED whose off-deadline has passed.
+ * @details An LED that expires is switched off the same way turnOff() does it: transparent, off, not blinking and in the lit phase. LEDs that were already off are only disarmed. The LEDs switched off in one pass are logged as one batch.
+ */
+void DurationScheduler::expire() {
+
+    Trace::Span span("DurationScheduler::expire");
+
+    BlinkScheduler::countWakeup();
+
+    expired.clear();
+    store->expireOffDeadlines(expired);
+
+    QScopedPointer<EventLog::Batch> batch; // Opened with the first LED switched off.
+    int switchedOff = 0;
+
+    for (int slot : expired) {
+        if (!store->isOn(slot)) {continue;}
+        if (switchedOff == 0) {batch.reset(new EventLog::Batch(EventLog::LedsExpired));} // Only logging passes that switch something off.
+        store->setRgba(slot, LedStore::Transparent);
+        store->setOn(slot, false);
+        store->setBlinkPeriod(slot, 0);
+        store->setBlinkPhase(slot, true);
+        EventLog::record(EventLog::LedExpired, store->displayIndex(slot) + 1);
+        ++switchedOff;
+    }
+
+    batch.reset(); // Recording the summary.
+    if (switchedOff > 0) {emit ledsExpired(switchedOff);}
+    reschedule();
+
+}
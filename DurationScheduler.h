@@ -0,0 +1,68 @@
+/**
+ * @file DurationScheduler.h
+ * @brief Defines the DurationScheduler class, which switches LEDs off when their duration runs out.
+ * @details This header file contains the declaration of the DurationScheduler class. The off-deadlines of all LEDs are indexed by the timing wheel in LedStore, and the scheduler keeps a single timer aimed at the nearest one. When it fires, every LED due at that time is switched off in one pass.
+ * @author Group 3
+ */
+
+#ifndef DURATIONSCHEDULER_H
+#define DURATIONSCHEDULER_H
+
+#include "include/models/LedStore.h"
+
+// Including necessary modules.
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+/**
+ * @class DurationScheduler
+ * @brief Expires LED off-deadlines with a single timer.
+ * @details The scheduler replaces one off timer per LED. Callers arm deadlines through LedStore::setOffDeadline() and then call reschedule(); cancelling needs no call, because a timer that fires without anything due simply reschedules itself.
+ * @author Group 3
+ */
+class DurationScheduler : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructor for DurationScheduler.
+     * @details Creates the wakeup timer without starting it.
+     * @param store The store holding the off-deadlines.
+     * @param parent The parent object.
+     */
+    explicit DurationScheduler(LedStore *store, QObject *parent = nullptr);
+
+    /**
+     * @brief Aims the wakeup timer at the nearest pending off-deadline.
+     * @details Must be called after arming new deadlines. Stops the timer if nothing is pending.
+     */
+    void reschedule();
+
+signals:
+
+    /**
+     * @brief Signal emitted after LEDs were switched off because their duration ran out.
+     * @param count The number of LEDs switched off in this pass.
+     */
+    void ledsExpired(int count);
+
+private slots:
+
+    /**
+     * @brief Switches off every LED whose off-deadline has passed.
+     * @details Collects the expired slots from the store, turns them off in one pass over the arrays and reschedules the timer.
+     */
+    void expire();
+
+private:
+
+    LedStore *store; // Store holding the LED state.
+    QTimer *wakeTimer; // Single timer aimed at the nearest off-deadline.
+    QVector<int> expired; // Slots expired in the current pass, kept to avoid reallocating.
+
+};
+
+#endif // DURATIONSCHEDULER_H
@@ -0,0 +1,58 @@
+/**
+ * @file Effect.h
+ * @brief Defines the Effect class, the interface of an animation computed over the whole LED array.
+ * @details This header file contains the declaration of the Effect class. Effects are rendered by the EffectEngine on worker threads, each worker computing one range of LEDs of the same frame.
+ * @author Group 3
+ */
+
+#ifndef EFFECT_H
+#define EFFECT_H
+
+// Including necessary modules.
+#include <QRgb>
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @class Effect
+ * @brief Computes the color of every LED for a point in time.
+ * @details An effect is a pure function of the frame context and the LED position: render() must not change the effect, since several threads call it at once on disjoint ranges of the same frame. Parameters are therefore fixed at construction; changing them means handing the engine a new effect. LEDs are addressed by their display position, so an effect that moves along the strip follows the order in which the LEDs are shown.
+ * @author Group 3
+ */
+class Effect {
+
+public:
+
+    /**
+     * @brief Describes the frame being rendered.
+     */
+    struct Context {
+        qint64 time; ///< Time of the frame in milliseconds since the engine started.
+        quint64 sequence; ///< Number of the frame, counting from 1.
+        int size; ///< Number of LEDs in the frame.
+    };
+
+    /**
+     * @brief Destructor for Effect.
+     */
+    virtual ~Effect() = default;
+
+    /**
+     * @brief Gets the name of the effect.
+     * @return QString The name, as used by the interfaces to select the effect.
+     */
+    virtual QString name() const = 0;
+
+    /**
+     * @brief Computes the colors of a range of LEDs.
+     * @details Must write every color of the range and nothing outside of it. The colors are opaque ARGB32.
+     * @param context The frame being rendered.
+     * @param colors The colors of the whole frame, context.size entries.
+     * @param first The display position of the first LED of the range.
+     * @param count The number of LEDs in the range.
+     */
+    virtual void render(const Context &context, QRgb *colors, int first, int count) const = 0;
+
+};
+
+#endif // EFFECT_H
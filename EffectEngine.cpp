@@ -0,0 +1,201 @@
+/**
+ * @file EffectEngine.cpp
+ * @brief Implementation of the EffectEngine class.
+ * @details This file contains the implementation of the EffectEngine class, including the producer thread that paces the frames, the partitioning of a frame into ranges for the worker pool, and the handoff of finished frames to the consumer.
+ * @see EffectEngine.h for the declaration of the EffectEngine class.
+ * @author Group 3
+ */
+
+#include "include/models/EffectEngine.h"
+#include "include/utils/Trace.h"
+
+// Including necessary modules.
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QSemaphore>
+#include <QThread>
+
+/**
+ * @brief Thread rendering frames at the frame interval.
+ * @details Only runs the engine's loop, so that the loop can use the engine's private state.
+ */
+class EffectEngine::Producer : public QThread {
+
+public:
+
+    QAtomicInt stopping{0}; // Set to 1 to make the thread finish.
+
+    explicit Producer(EffectEngine *engine) : engine(engine) {}
+
+protected:
+
+    void run() override {
+        engine->run(stopping);
+    }
+
+private:
+
+    EffectEngine *engine; // Engine whose frames are rendered.
+
+};
+
+/**
+ * @brief Constructs an EffectEngine.
+ * @details The worker threads are kept alive between frames, so rendering a frame never starts a thread.
+ * @param parent The parent object.
+ */
+EffectEngine::EffectEngine(QObject *parent) : QObject(parent) {
+    workers.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+    workers.setExpiryTimeout(-1);
+}
+
+/**
+ * @brief Destroys the EffectEngine.
+ */
+EffectEngine::~EffectEngine() {
+    stop();
+}
+
+/**
+ * @brief Sets the effect to render.
+ * @details The producer thread picks up the new effect with its next frame.
+ * @param effect The effect, or nullptr to stop rendering.
+ */
+void EffectEngine::setEffect(QSharedPointer<const Effect> effect) {
+
+    {
+        QMutexLocker locker(&effectMutex);
+        current = effect;
+    }
+
+    if (!effect) {
+        stop();
+        takeFrame(); // Dropping the frame rendered last, so that a stopped effect is never shown again.
+    } else if (!producer) {
+        producer = new Producer(this);
+        producer->start();
+    }
+
+}
+
+/**
+ * @brief Gets the effect being rendered.
+ * @return The effect, or nullptr.
+ */
+QSharedPointer<const Effect> EffectEngine::effect() const {
+    QMutexLocker locker(&effectMutex);
+    return current;
+}
+
+/**
+ * @brief Sets the number of LEDs of the next frames.
+ * @param count The number of LEDs.
+ */
+void EffectEngine::setLedCount(int count) {
+    ledCount.storeRelaxed(count);
+}
+
+/**
+ * @brief Takes the latest frame, if there is a new one.
+ * @details The notification flag is cleared first, so a frame published while taking still raises frameReady().
+ * @return True if frame() holds a new frame.
+ */
+bool EffectEngine::takeFrame() {
+    notified.storeRelease(0);
+    return frames.take();
+}
+
+/**
+ * @brief Gets the frame taken last.
+ * @return The frame.
+ */
+const EffectEngine::Frame &EffectEngine::frame() const {
+    return frames.front();
+}
+
+/**
+ * @brief Renders one frame of an effect on the calling thread and the worker pool.
+ * @details The range length is rounded up to whole 64-LED blocks, so no two threads write to the same cache line. The ranges only share read-only state, so the threads never synchronize until the calling thread waits for them at the end.
+ * @param effect The effect to render.
+ * @param context The frame being rendered.
+ * @param colors The colors to write.
+ */
+void EffectEngine::render(const Effect &effect, const Effect::Context &context, QVector<QRgb> &colors) {
+
+    colors.resize(context.size);
+    if (context.size == 0) {return;}
+
+    int ranges = qBound(1, context.size / MinRange, threadCount());
+    const int length = (((context.size + ranges - 1) / ranges) + 63) & ~63;
+    ranges = (context.size + length - 1) / length; // Rounding up the length may leave fewer ranges.
+
+    QRgb *data = colors.data();
+    QSemaphore done;
+    for (int r = 0; r < ranges - 1; ++r) {
+        const int first = r * length;
+        workers.start([&effect, &context, &done, data, first, length]() {
+            effect.render(context, data, first, length);
+            done.release();
+        });
+    }
+
+    const int first = (ranges - 1) * length;
+    effect.render(context, data, first, context.size - first); // The last range, which may be shorter.
+    done.acquire(ranges - 1);
+
+}
+
+/**
+ * @brief Gets the number of threads rendering a large frame.
+ * @return The number of threads.
+ */
+int EffectEngine::threadCount() const {
+    return workers.maxThreadCount() + 1;
+}
+
+/**
+ * @brief Renders and publishes frames until stopped.
+ * @details Each frame takes a reference to the current effect once, so an effect that is replaced meanwhile stays alive until the frame is done. The thread sleeps for whatever is left of the frame interval; a frame that takes longer than the interval is followed by the next one right away.
+ * @param stopping Set to 1 to make the loop finish.
+ */
+void EffectEngine::run(const QAtomicInt &stopping) {
+
+    QElapsedTimer clock;
+    clock.start();
+    quint64 sequence = 0;
+
+    while (!stopping.loadAcquire()) {
+
+        const qint64 started = clock.elapsed();
+        const QSharedPointer<const Effect> effect = this->effect();
+        if (!effect) {break;}
+
+        Frame &frame = frames.back();
+        frame.sequence = ++sequence;
+        frame.time = started;
+        const Effect::Context context = {started, frame.sequence, ledCount.loadRelaxed()};
+        {
+            Trace::Span span("EffectEngine::render");
+            render(*effect, context, frame.colors);
+        }
+        frames.publish();
+
+        if (notified.testAndSetAcquire(0, 1)) {emit frameReady();} // Only one notification in flight.
+
+        const qint64 remaining = FrameInterval - (clock.elapsed() - started);
+        if (remaining > 0) {QThread::msleep(quint64(remaining));}
+
+    }
+
+}
+
+/**
+ * @brief Stops the producer thread and waits for it.
+ */
+void EffectEngine::stop() {
+    if (!producer) {return;}
+    producer->stopping.storeRelease(1);
+    producer->wait();
+    delete producer;
+    producer = nullptr;
+}
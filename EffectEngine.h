@@ -0,0 +1,148 @@
+/**
+ * @file EffectEngine.h
+ * @brief Defines the EffectEngine class, which renders animation frames off the GUI thread.
+ * @details This header file contains the declaration of the EffectEngine class. A producer thread renders one frame of LED colors per frame interval, splitting the LEDs into ranges that are computed in parallel by a pool of worker threads, and hands each finished frame to the consumer through a lock-free triple buffer. The GUI thread only copies the latest frame into the effect layer of the output frame, so a heavy effect slows down the frame rate of the animation but never the handling of input.
+ * @author Group 3
+ */
+
+#ifndef EFFECTENGINE_H
+#define EFFECTENGINE_H
+
+#include "include/models/Effect.h"
+#include "include/utils/TripleBuffer.h"
+
+// Including necessary modules.
+#include <QAtomicInt>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QVector>
+
+/**
+ * @class EffectEngine
+ * @brief Renders the running effect into frames on worker threads.
+ * @details The engine runs while an effect is set. Every frame is rendered into the back buffer of a TripleBuffer, whose colors are indexed by display position, and published without taking a lock; frameReady() is emitted only if the consumer took the previous notification, so a busy GUI thread does not pile up queued signals. The effect and the number of LEDs are the only state shared with the producer thread: the LED count is an atomic, and the effect is swapped under a mutex that the producer takes once per frame, never per LED. There is a single consumer, the thread that calls takeFrame().
+ * @author Group 3
+ */
+class EffectEngine : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief One rendered frame.
+     */
+    struct Frame {
+        QVector<QRgb> colors; ///< Color of each LED by display position.
+        quint64 sequence = 0; ///< Number of the frame, 0 if nothing was rendered yet.
+        qint64 time = 0; ///< Time of the frame in milliseconds since the engine started.
+    };
+
+    /**
+     * @brief Constructor for EffectEngine.
+     * @details Creates the worker pool with one thread less than the ideal thread count, since the producer thread renders one range itself. No thread runs until an effect is set.
+     * @param parent The parent object.
+     */
+    explicit EffectEngine(QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor for EffectEngine.
+     * @details Stops the producer thread and waits for it.
+     */
+    ~EffectEngine();
+
+    /**
+     * @brief Sets the effect to render.
+     * @details Starts the producer thread if it is not running. Setting nullptr stops it and drops a frame that was published but not taken yet, so that takeFrame() returns false until a new effect renders a frame.
+     * @param effect The effect, or nullptr to stop rendering.
+     */
+    void setEffect(QSharedPointer<const Effect> effect);
+
+    /**
+     * @brief Gets the effect being rendered.
+     * @return QSharedPointer<const Effect> The effect, or nullptr if the engine is stopped.
+     */
+    QSharedPointer<const Effect> effect() const;
+
+    /**
+     * @brief Sets the number of LEDs of the next frames.
+     * @details Frames already published keep their size, so the consumer has to check it.
+     * @param count The number of LEDs.
+     */
+    void setLedCount(int count);
+
+    /**
+     * @brief Takes the latest frame, if there is a new one.
+     * @details Only to be called from one thread, normally the GUI thread in response to frameReady().
+     * @return bool True if frame() now holds a frame that was not taken before.
+     */
+    bool takeFrame();
+
+    /**
+     * @brief Gets the frame taken last.
+     * @return const Frame& The frame. It stays unchanged until the next takeFrame().
+     */
+    const Frame &frame() const;
+
+    /**
+     * @brief Renders one frame of an effect on the calling thread and the worker pool.
+     * @details Splits the LEDs into at most one range per thread, each a multiple of 64 LEDs and no smaller than MinRange, renders all ranges but the last on the pool and the last on the calling thread, and returns once every range is done. Used by the producer thread, and directly by the benchmark.
+     * @param effect The effect to render.
+     * @param context The frame being rendered; context.size is the number of LEDs.
+     * @param colors The colors to write, resized to context.size.
+     */
+    void render(const Effect &effect, const Effect::Context &context, QVector<QRgb> &colors);
+
+    /**
+     * @brief Gets the number of threads rendering a large frame.
+     * @return int The worker threads plus the producer thread.
+     */
+    int threadCount() const;
+
+    /**
+     * @brief Interval between two frames in milliseconds.
+     */
+    static const int FrameInterval = 16;
+
+    /**
+     * @brief Smallest number of LEDs worth handing to another thread.
+     */
+    static const int MinRange = 4096;
+
+signals:
+
+    /**
+     * @brief Signal emitted from the producer thread when a new frame is available.
+     * @details Delivered to the consumer as a queued signal. Not emitted again until takeFrame() was called.
+     */
+    void frameReady();
+
+private:
+
+    class Producer;
+
+    TripleBuffer<Frame> frames; // Handoff of frames from the producer thread to the consumer.
+    mutable QMutex effectMutex; // Guards current against the producer thread.
+    QSharedPointer<const Effect> current; // Effect being rendered.
+    QAtomicInt ledCount{0}; // Number of LEDs of the next frame.
+    QAtomicInt notified{0}; // 1 while a frameReady() signal has not been answered by takeFrame().
+    QThreadPool workers; // Threads rendering all ranges but the last.
+    Producer *producer = nullptr; // Thread rendering frames at the frame interval, while running.
+
+    /**
+     * @brief Renders and publishes frames until stopped.
+     * @details Runs on the producer thread.
+     * @param stopping Set to 1 to make the loop finish.
+     */
+    void run(const QAtomicInt &stopping);
+
+    /**
+     * @brief Stops the producer thread and waits for it.
+     */
+    void stop();
+
+};
+
+#endif // EFFECTENGINE_H
@@ -0,0 +1,528 @@
+/**
+ * @file EffectKernels.cpp
+ * @brief Implementation of the EffectKernels class.
+ * @details This file contains the scalar, SSE2 and AVX2 implementations of the effect kernels and the dispatch between them. The vector implementations process 4 or 8 LEDs per iteration in 32-bit lanes and hand the remaining LEDs of a range to the scalar implementation. Products of a channel and a level never exceed 16 bits, so they use 16-bit multiplies on the 32-bit lanes, whose upper halves are always zero.
+ * @see EffectKernels.h for the declaration of the EffectKernels class.
+ * @author Group 3
+ */
+
+#include "include/utils/EffectKernels.h"
+#include "include/utils/CpuFeatures.h"
+
+#ifdef PILLUMINATE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const quint32 GreenOffset = 0x55555555u; // Hue of pure green, a third of a turn.
+const quint32 BlueOffset = 0xAAAAAAAAu; // Hue of pure blue, two thirds of a turn.
+const quint32 TickSeed = 0x632BE5ABu; // Spreads consecutive fire ticks over the hash input.
+
+/**
+ * @brief Clamps a value to a color channel.
+ * @param value The value.
+ * @return The value limited to 0 to 255.
+ */
+inline int clampByte(int value) {
+    return qBound(0, value, 255);
+}
+
+/**
+ * @brief Packs channels into an opaque color.
+ * @param r The red channel.
+ * @param g The green channel.
+ * @param b The blue channel.
+ * @return The color.
+ */
+inline QRgb opaque(int r, int g, int b) {
+    return 0xff000000u | (quint32(r) << 16) | (quint32(g) << 8) | quint32(b);
+}
+
+/**
+ * @brief Gets the position in a cycle relative to its middle.
+ * @param phase The phase.
+ * @return The top 16 bits of the phase as a signed number, from -32768 to 32767.
+ */
+inline int centered(quint32 phase) {
+    return qint32(phase) >> 16;
+}
+
+/**
+ * @brief Gets one channel of a fully saturated hue.
+ * @details The channel is 255 within a sixth of a turn of its own hue, falls linearly to 0 over the next sixth and stays 0 for the opposite third.
+ * @param phase The hue relative to the channel's own hue.
+ * @return The channel.
+ */
+inline int hueLevel(quint32 phase) {
+    return clampByte(((21845 - qAbs(centered(phase))) * 3) >> 7);
+}
+
+/**
+ * @brief Gets the weight of the second color of a gradient.
+ * @param phase The position in the cycle.
+ * @return The weight, from 0 in the middle of the cycle to 256 at its ends.
+ */
+inline int blendLevel(quint32 phase) {
+    return qAbs(centered(phase)) >> 7;
+}
+
+/**
+ * @brief Gets the brightness of a wave.
+ * @details The sine shape is a parabola, 1 - x², which is close enough to a cosine lobe for a brightness and needs only one multiply.
+ * @param phase The position in the cycle.
+ * @param shape The shape.
+ * @return The brightness, from 0 to 256.
+ */
+inline int shapeLevel(quint32 phase, EffectKernels::Shape shape) {
+    const int x = centered(phase);
+    if (shape == EffectKernels::Sine) {
+        const int y = qAbs(x) >> 8;
+        return 256 - ((y * y) >> 6);
+    }
+    return qMax(0, x - 16384) >> 6;
+}
+
+/**
+ * @brief Gets the brightness of a twinkling LED.
+ * @param phase The position of the LED in its cycle.
+ * @return The brightness, from 0 to 256.
+ */
+inline int twinkleLevel(quint32 phase) {
+    return qMax(0, 8192 - qAbs(centered(phase))) >> 5;
+}
+
+/**
+ * @brief Scrambles a number.
+ * @details Two multiply-xorshift rounds, enough for neighbouring LEDs to look unrelated.
+ * @param x The number.
+ * @return The hash.
+ */
+inline quint32 hash(quint32 x) {
+    x *= 0x9E3779B1u;
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    return x;
+}
+
+/**
+ * @brief Scales a color by a brightness.
+ * @param color The color.
+ * @param level The brightness, from 0 to 256.
+ * @return The scaled color.
+ */
+inline QRgb scaled(QRgb color, int level) {
+    return opaque((qRed(color) * level) >> 8, (qGreen(color) * level) >> 8, (qBlue(color) * level) >> 8);
+}
+
+/**
+ * @brief Gets the color of a burning LED.
+ * @param position The position of the LED.
+ * @param seed The seed of the current tick.
+ * @param fraction How far the frame is into the tick.
+ * @return The color.
+ */
+inline QRgb flame(quint32 position, quint32 seed, int fraction) {
+    const int now = int(hash(position + seed) >> 24);
+    const int next = int(hash(position + seed + TickSeed) >> 24);
+    int heat = (now * (256 - fraction) + next * fraction) >> 8;
+    heat = (heat * heat) >> 8; // Keeping most LEDs dim.
+    const int t = (heat * 3) >> 1;
+    return opaque(qMin(255, t), clampByte(t - 127), 0);
+}
+
+/**
+ * @brief Scalar implementation of EffectKernels::hueRamp().
+ * @details The scalar implementations also finish the LEDs left over by the vector implementations.
+ */
+void hueRampScalar(QRgb *colors, int count, quint32 phase, quint32 step) {
+    for (int k = 0; k < count; ++k, phase += step) {
+        colors[k] = opaque(hueLevel(phase), hueLevel(phase - GreenOffset), hueLevel(phase - BlueOffset));
+    }
+}
+
+/**
+ * @brief Scalar implementation of EffectKernels::gradient().
+ */
+void gradientScalar(QRgb *colors, int count, quint32 phase, quint32 step, QRgb from, QRgb to) {
+    for (int k = 0; k < count; ++k, phase += step) {
+        const int w = blendLevel(phase);
+        colors[k] = opaque((qRed(from) * (256 - w) + qRed(to) * w) >> 8,
+                           (qGreen(from) * (256 - w) + qGreen(to) * w) >> 8,
+                           (qBlue(from) * (256 - w) + qBlue(to) * w) >> 8);
+    }
+}
+
+/**
+ * @brief Scalar implementation of EffectKernels::wave().
+ */
+void waveScalar(QRgb *colors, int count, quint32 phase, quint32 step, QRgb color, EffectKernels::Shape shape) {
+    for (int k = 0; k < count; ++k, phase += step) {colors[k] = scaled(color, shapeLevel(phase, shape));}
+}
+
+/**
+ * @brief Scalar implementation of EffectKernels::twinkle().
+ */
+void twinkleScalar(QRgb *colors, int count, int first, quint32 phase, QRgb color) {
+    for (int k = 0; k < count; ++k) {colors[k] = scaled(color, twinkleLevel(phase + hash(quint32(first + k))));}
+}
+
+/**
+ * @brief Scalar implementation of EffectKernels::fire().
+ */
+void fireScalar(QRgb *colors, int count, int first, quint32 tick, int fraction) {
+    const quint32 seed = tick * TickSeed;
+    for (int k = 0; k < count; ++k) {colors[k] = flame(quint32(first + k), seed, fraction);}
+}
+
+#ifdef PILLUMINATE_X86_SIMD
+
+// SSE2: 4 LEDs per iteration. SSE2 has no 32-bit absolute value, minimum or maximum, so those are built from shifts and masks.
+
+/**
+ * @brief Absolute value of four 32-bit lanes.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128i abs4(__m128i v) {
+    const __m128i sign = _mm_srai_epi32(v, 31);
+    return _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+}
+
+/**
+ * @brief clampByte() on four lanes.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128i clampByte4(__m128i v) {
+    v = _mm_andnot_si128(_mm_srai_epi32(v, 31), v); // Negative values become 0.
+    v = _mm_or_si128(v, _mm_srai_epi32(_mm_sub_epi32(_mm_set1_epi32(255), v), 31)); // Values above 255 become all ones...
+    return _mm_and_si128(v, _mm_set1_epi32(255)); // ...and then 255.
+}
+
+/**
+ * @brief opaque() on four lanes.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128i opaque4(__m128i r, __m128i g, __m128i b) {
+    const __m128i rg = _mm_or_si128(_mm_slli_epi32(r, 16), _mm_slli_epi32(g, 8));
+    return _mm_or_si128(_mm_or_si128(rg, b), _mm_set1_epi32(int(0xff000000u)));
+}
+
+/**
+ * @brief Phases of four neighbouring LEDs.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128i ramp4(quint32 phase, quint32 step) {
+    return _mm_add_epi32(_mm_set1_epi32(int(phase)), _mm_setr_epi32(0, int(step), int(2 * step), int(3 * step)));
+}
+
+/**
+ * @brief hueLevel() on four lanes.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128i hueLevel4(__m128i phase) {
+    __m128i v = _mm_sub_epi32(_mm_set1_epi32(21845), abs4(_mm_srai_epi32(phase, 16)));
+    v = _mm_add_epi32(v, _mm_add_epi32(v, v));
+    return clampByte4(_mm_srai_epi32(v, 7));
+}
+
+/**
+ * @brief One channel of scaled() on four lanes.
+ */
+PILLUMINATE_TARGET("sse2") inline __m128i scale4(int channel, __m128i level) {
+    return _mm_srli_epi32(_mm_mullo_epi16(_mm_set1_epi32(channel), level), 8);
+}
+
+/**
+ * @brief SSE2 implementation of EffectKernels::hueRamp().
+ */
+PILLUMINATE_TARGET("sse2") void hueRampSse2(QRgb *colors, int count, quint32 phase, quint32 step) {
+    __m128i p = ramp4(phase, step);
+    const __m128i advance = _mm_set1_epi32(int(4 * step));
+    const __m128i green = _mm_set1_epi32(int(GreenOffset));
+    const __m128i blue = _mm_set1_epi32(int(BlueOffset));
+    int k = 0;
+    for (; k + 4 <= count; k += 4, p = _mm_add_epi32(p, advance)) {
+        const __m128i r = hueLevel4(p);
+        const __m128i g = hueLevel4(_mm_sub_epi32(p, green));
+        const __m128i b = hueLevel4(_mm_sub_epi32(p, blue));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colors + k), opaque4(r, g, b));
+    }
+    hueRampScalar(colors + k, count - k, phase + quint32(k) * step, step);
+}
+
+/**
+ * @brief SSE2 implementation of EffectKernels::gradient().
+ */
+PILLUMINATE_TARGET("sse2") void gradientSse2(QRgb *colors, int count, quint32 phase, quint32 step, QRgb from, QRgb to) {
+    __m128i p = ramp4(phase, step);
+    const __m128i advance = _mm_set1_epi32(int(4 * step));
+    const __m128i full = _mm_set1_epi32(256);
+    int k = 0;
+    for (; k + 4 <= count; k += 4, p = _mm_add_epi32(p, advance)) {
+        const __m128i w = _mm_srli_epi32(abs4(_mm_srai_epi32(p, 16)), 7);
+        const __m128i rest = _mm_sub_epi32(full, w);
+        const __m128i r = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(_mm_set1_epi32(qRed(from)), rest), _mm_mullo_epi16(_mm_set1_epi32(qRed(to)), w)), 8);
+        const __m128i g = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(_mm_set1_epi32(qGreen(from)), rest), _mm_mullo_epi16(_mm_set1_epi32(qGreen(to)), w)), 8);
+        const __m128i b = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(_mm_set1_epi32(qBlue(from)), rest), _mm_mullo_epi16(_mm_set1_epi32(qBlue(to)), w)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colors + k), opaque4(r, g, b));
+    }
+    gradientScalar(colors + k, count - k, phase + quint32(k) * step, step, from, to);
+}
+
+/**
+ * @brief SSE2 implementation of EffectKernels::wave().
+ */
+PILLUMINATE_TARGET("sse2") void waveSse2(QRgb *colors, int count, quint32 phase, quint32 step, QRgb color, EffectKernels::Shape shape) {
+    __m128i p = ramp4(phase, step);
+    const __m128i advance = _mm_set1_epi32(int(4 * step));
+    int k = 0;
+    for (; k + 4 <= count; k += 4, p = _mm_add_epi32(p, advance)) {
+        const __m128i x = _mm_srai_epi32(p, 16);
+        __m128i level;
+        if (shape == EffectKernels::Sine) {
+            const __m128i y = _mm_srli_epi32(abs4(x), 8);
+            level = _mm_sub_epi32(_mm_set1_epi32(256), _mm_srli_epi32(_mm_mullo_epi16(y, y), 6));
+        } else {
+            const __m128i above = _mm_sub_epi32(x, _mm_set1_epi32(16384));
+            level = _mm_srai_epi32(_mm_andnot_si128(_mm_srai_epi32(above, 31), above), 6);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colors + k), opaque4(scale4(qRed(color), level), scale4(qGreen(color), level), scale4(qBlue(color), level)));
+    }
+    waveScalar(colors + k, count - k, phase + quint32(k) * step, step, color, shape);
+}
+
+// AVX2: 8 LEDs per iteration, with native absolute value, minimum, maximum and 32-bit multiplies.
+
+/**
+ * @brief clampByte() on eight lanes.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256i clampByte8(__m256i v) {
+    return _mm256_min_epi32(_mm256_max_epi32(v, _mm256_setzero_si256()), _mm256_set1_epi32(255));
+}
+
+/**
+ * @brief opaque() on eight lanes.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256i opaque8(__m256i r, __m256i g, __m256i b) {
+    const __m256i rg = _mm256_or_si256(_mm256_slli_epi32(r, 16), _mm256_slli_epi32(g, 8));
+    return _mm256_or_si256(_mm256_or_si256(rg, b), _mm256_set1_epi32(int(0xff000000u)));
+}
+
+/**
+ * @brief Phases of eight neighbouring LEDs.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256i ramp8(quint32 phase, quint32 step) {
+    return _mm256_add_epi32(_mm256_set1_epi32(int(phase)), _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(int(step))));
+}
+
+/**
+ * @brief hueLevel() on eight lanes.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256i hueLevel8(__m256i phase) {
+    __m256i v = _mm256_sub_epi32(_mm256_set1_epi32(21845), _mm256_abs_epi32(_mm256_srai_epi32(phase, 16)));
+    v = _mm256_add_epi32(v, _mm256_add_epi32(v, v));
+    return clampByte8(_mm256_srai_epi32(v, 7));
+}
+
+/**
+ * @brief One channel of scaled() on eight lanes.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256i scale8(int channel, __m256i level) {
+    return _mm256_srli_epi32(_mm256_mullo_epi16(_mm256_set1_epi32(channel), level), 8);
+}
+
+/**
+ * @brief scaled() on eight lanes.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256i scaled8(QRgb color, __m256i level) {
+    return opaque8(scale8(qRed(color), level), scale8(qGreen(color), level), scale8(qBlue(color), level));
+}
+
+/**
+ * @brief hash() on eight lanes.
+ */
+PILLUMINATE_TARGET("avx2") inline __m256i hash8(__m256i x) {
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(int(0x9E3779B1u)));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(int(0x85EBCA6Bu)));
+    return _mm256_xor_si256(x, _mm256_srli_epi32(x, 13));
+}
+
+/**
+ * @brief AVX2 implementation of EffectKernels::hueRamp().
+ */
+PILLUMINATE_TARGET("avx2") void hueRampAvx2(QRgb *colors, int count, quint32 phase, quint32 step) {
+    __m256i p = ramp8(phase, step);
+    const __m256i advance = _mm256_set1_epi32(int(8 * step));
+    const __m256i green = _mm256_set1_epi32(int(GreenOffset));
+    const __m256i blue = _mm256_set1_epi32(int(BlueOffset));
+    int k = 0;
+    for (; k + 8 <= count; k += 8, p = _mm256_add_epi32(p, advance)) {
+        const __m256i r = hueLevel8(p);
+        const __m256i g = hueLevel8(_mm256_sub_epi32(p, green));
+        const __m256i b = hueLevel8(_mm256_sub_epi32(p, blue));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colors + k), opaque8(r, g, b));
+    }
+    hueRampScalar(colors + k, count - k, phase + quint32(k) * step, step);
+}
+
+/**
+ * @brief AVX2 implementation of EffectKernels::gradient().
+ */
+PILLUMINATE_TARGET("avx2") void gradientAvx2(QRgb *colors, int count, quint32 phase, quint32 step, QRgb from, QRgb to) {
+    __m256i p = ramp8(phase, step);
+    const __m256i advance = _mm256_set1_epi32(int(8 * step));
+    const __m256i full = _mm256_set1_epi32(256);
+    int k = 0;
+    for (; k + 8 <= count; k += 8, p = _mm256_add_epi32(p, advance)) {
+        const __m256i w = _mm256_srli_epi32(_mm256_abs_epi32(_mm256_srai_epi32(p, 16)), 7);
+        const __m256i rest = _mm256_sub_epi32(full, w);
+        const __m256i r = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi16(_mm256_set1_epi32(qRed(from)), rest), _mm256_mullo_epi16(_mm256_set1_epi32(qRed(to)), w)), 8);
+        const __m256i g = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi16(_mm256_set1_epi32(qGreen(from)), rest), _mm256_mullo_epi16(_mm256_set1_epi32(qGreen(to)), w)), 8);
+        const __m256i b = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi16(_mm256_set1_epi32(qBlue(from)), rest), _mm256_mullo_epi16(_mm256_set1_epi32(qBlue(to)), w)), 8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colors + k), opaque8(r, g, b));
+    }
+    gradientScalar(colors + k, count - k, phase + quint32(k) * step, step, from, to);
+}
+
+/**
+ * @brief AVX2 implementation of EffectKernels::wave().
+ */
+PILLUMINATE_TARGET("avx2") void waveAvx2(QRgb *colors, int count, quint32 phase, quint32 step, QRgb color, EffectKernels::Shape shape) {
+    __m256i p = ramp8(phase, step);
+    const __m256i advance = _mm256_set1_epi32(int(8 * step));
+    int k = 0;
+    for (; k + 8 <= count; k += 8, p = _mm256_add_epi32(p, advance)) {
+        const __m256i x = _mm256_srai_epi32(p, 16);
+        __m256i level;
+        if (shape == EffectKernels::Sine) {
+            const __m256i y = _mm256_srli_epi32(_mm256_abs_epi32(x), 8);
+            level = _mm256_sub_epi32(_mm256_set1_epi32(256), _mm256_srli_epi32(_mm256_mullo_epi16(y, y), 6));
+        } else {
+            level = _mm256_srai_epi32(_mm256_max_epi32(_mm256_sub_epi32(x, _mm256_set1_epi32(16384)), _mm256_setzero_si256()), 6);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colors + k), scaled8(color, level));
+    }
+    waveScalar(colors + k, count - k, phase + quint32(k) * step, step, color, shape);
+}
+
+/**
+ * @brief AVX2 implementation of EffectKernels::twinkle().
+ */
+PILLUMINATE_TARGET("avx2") void twinkleAvx2(QRgb *colors, int count, int first, quint32 phase, QRgb color) {
+    __m256i position = _mm256_add_epi32(_mm256_set1_epi32(first), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m256i shared = _mm256_set1_epi32(int(phase));
+    int k = 0;
+    for (; k + 8 <= count; k += 8, position = _mm256_add_epi32(position, _mm256_set1_epi32(8))) {
+        const __m256i x = _mm256_srai_epi32(_mm256_add_epi32(shared, hash8(position)), 16);
+        const __m256i level = _mm256_srai_epi32(_mm256_max_epi32(_mm256_sub_epi32(_mm256_set1_epi32(8192), _mm256_abs_epi32(x)), _mm256_setzero_si256()), 5);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colors + k), scaled8(color, level));
+    }
+    twinkleScalar(colors + k, count - k, first + k, phase, color);
+}
+
+/**
+ * @brief AVX2 implementation of EffectKernels::fire().
+ */
+PILLUMINATE_TARGET("avx2") void fireAvx2(QRgb *colors, int count, int first, quint32 tick, int fraction) {
+    const quint32 seed = tick * TickSeed;
+    __m256i position = _mm256_add_epi32(_mm256_set1_epi32(first), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m256i nowSeed = _mm256_set1_epi32(int(seed));
+    const __m256i nextSeed = _mm256_set1_epi32(int(seed + TickSeed));
+    const __m256i weight = _mm256_set1_epi32(fraction);
+    const __m256i rest = _mm256_set1_epi32(256 - fraction);
+    int k = 0;
+    for (; k + 8 <= count; k += 8, position = _mm256_add_epi32(position, _mm256_set1_epi32(8))) {
+        const __m256i now = _mm256_srli_epi32(hash8(_mm256_add_epi32(position, nowSeed)), 24);
+        const __m256i next = _mm256_srli_epi32(hash8(_mm256_add_epi32(position, nextSeed)), 24);
+        __m256i heat = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi16(now, rest), _mm256_mullo_epi16(next, weight)), 8);
+        heat = _mm256_srli_epi32(_mm256_mullo_epi16(heat, heat), 8);
+        const __m256i t = _mm256_srli_epi32(_mm256_add_epi32(heat, _mm256_add_epi32(heat, heat)), 1);
+        const __m256i r = _mm256_min_epi32(t, _mm256_set1_epi32(255));
+        const __m256i g = clampByte8(_mm256_sub_epi32(t, _mm256_set1_epi32(127)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colors + k), opaque8(r, g, _mm256_setzero_si256()));
+    }
+    fireScalar(colors + k, count - k, first + k, tick, fraction);
+}
+
+#endif
+
+}
+
+/**
+ * @brief Fills colors with fully saturated hues.
+ * @param colors The colors to write.
+ * @param count The number of colors.
+ * @param phase The hue of the first color.
+ * @param step The hue difference between neighbouring colors.
+ */
+void EffectKernels::hueRamp(QRgb *colors, int count, quint32 phase, quint32 step) {
+#ifdef PILLUMINATE_X86_SIMD
+    const CpuFeatures::Level level = CpuFeatures::level();
+    if (level == CpuFeatures::Avx2) {hueRampAvx2(colors, count, phase, step); return;}
+    if (level == CpuFeatures::Sse2) {hueRampSse2(colors, count, phase, step); return;}
+#endif
+    hueRampScalar(colors, count, phase, step);
+}
+
+/**
+ * @brief Fills colors with a blend that goes from one color to another and back.
+ * @param colors The colors to write.
+ * @param count The number of colors.
+ * @param phase The position of the first color in the cycle.
+ * @param step The difference in position between neighbouring colors.
+ * @param from The color in the middle of the cycle.
+ * @param to The color at the ends of the cycle.
+ */
+void EffectKernels::gradient(QRgb *colors, int count, quint32 phase, quint32 step, QRgb from, QRgb to) {
+#ifdef PILLUMINATE_X86_SIMD
+    const CpuFeatures::Level level = CpuFeatures::level();
+    if (level == CpuFeatures::Avx2) {gradientAvx2(colors, count, phase, step, from, to); return;}
+    if (level == CpuFeatures::Sse2) {gradientSse2(colors, count, phase, step, from, to); return;}
+#endif
+    gradientScalar(colors, count, phase, step, from, to);
+}
+
+/**
+ * @brief Fills colors with one color whose brightness follows a shape.
+ * @param colors The colors to write.
+ * @param count The number of colors.
+ * @param phase The position of the first color in the cycle.
+ * @param step The difference in position between neighbouring colors.
+ * @param color The color at full brightness.
+ * @param shape The shape of the brightness over a cycle.
+ */
+void EffectKernels::wave(QRgb *colors, int count, quint32 phase, quint32 step, QRgb color, Shape shape) {
+#ifdef PILLUMINATE_X86_SIMD
+    const CpuFeatures::Level level = CpuFeatures::level();
+    if (level == CpuFeatures::Avx2) {waveAvx2(colors, count, phase, step, color, shape); return;}
+    if (level == CpuFeatures::Sse2) {waveSse2(colors, count, phase, step, color, shape); return;}
+#endif
+    waveScalar(colors, count, phase, step, color, shape);
+}
+
+/**
+ * @brief Fills colors with one color flashing up at random moments.
+ * @param colors The colors to write.
+ * @param count The number of colors.
+ * @param first The position of the first color in the whole frame.
+ * @param phase The position in the cycle shared by all LEDs.
+ * @param color The color at full brightness.
+ */
+void EffectKernels::twinkle(QRgb *colors, int count, int first, quint32 phase, QRgb color) {
+#ifdef PILLUMINATE_X86_SIMD
+    if (CpuFeatures::level() == CpuFeatures::Avx2) {twinkleAvx2(colors, count, first, phase, color); return;}
+#endif
+    twinkleScalar(colors, count, first, phase, color);
+}
+
+/**
+ * @brief Fills colors with flickering fire.
+ * @param colors The colors to write.
+ * @param count The number of colors.
+ * @param first The position of the first color in the whole frame.
+ * @param tick The number of the current tick.
+ * @param fraction How far the frame is into the tick.
+ */
+void EffectKernels::fire(QRgb *colors, int count, int first, quint32 tick, int fraction) {
+#ifdef PILLUMINATE_X86_SIMD
+    if (CpuFeatures::level() == CpuFeatures::Avx2) {fireAvx2(colors, count, first, tick, fraction); return;}
+#endif
+    fireScalar(colors, count, first, tick, fraction);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file EffectKernels.h
+ * @brief Defines the EffectKernels class, the vectorized loops behind the built-in effects.
+ * @details This header file contains the declaration of the EffectKernels class. Each kernel fills a packed array of ARGB32 colors in one pass, using integer arithmetic only, with an AVX2, an SSE2 and a scalar implementation selected by CpuFeatures.
+ * @author Group 3
+ */
+
+#ifndef EFFECTKERNELS_H
+#define EFFECTKERNELS_H
+
+// Including necessary modules.
+#include <QRgb>
+#include <QtGlobal>
+
+/**
+ * @class EffectKernels
+ * @brief Fills color arrays for the effects.
+ * @details Positions in a cycle are 32-bit phases, a full turn being 2^32, so they wrap for free and the phase of LED k of a range is phase + k * step. Shapes are derived from the top 16 bits of the phase read as a signed number, which puts the middle of every cycle at 0. Every implementation of a kernel performs the same integer operations, so all of them give bit-identical results. twinkle() and fire() hash the LED position, which needs 32-bit multiplies that SSE2 lacks, so they run the scalar path unless AVX2 is available. The colors written are always opaque.
+ * @author Group 3
+ */
+class EffectKernels {
+
+public:
+
+    /**
+     * @brief Shapes of the brightness of wave().
+     */
+    enum Shape {
+        Sine, ///< Smooth hump centered on the middle of the cycle, dark at its ends.
+        Pulse ///< Dark for three quarters of the cycle, then fading in up to a sharp head at its end.
+    };
+
+    /**
+     * @brief Fills colors with fully saturated hues.
+     * @details The hue goes once around the color wheel over a full turn of the phase, starting at red.
+     * @param colors The colors to write.
+     * @param count The number of colors.
+     * @param phase The hue of the first color.
+     * @param step The hue difference between neighbouring colors.
+     */
+    static void hueRamp(QRgb *colors, int count, quint32 phase, quint32 step);
+
+    /**
+     * @brief Fills colors with a blend that goes from one color to another and back.
+     * @details The middle of the cycle is the first color and its ends are the second one, with a linear blend in between.
+     * @param colors The colors to write.
+     * @param count The number of colors.
+     * @param phase The position of the first color in the cycle.
+     * @param step The difference in position between neighbouring colors.
+     * @param from The color in the middle of the cycle.
+     * @param to The color at the ends of the cycle.
+     */
+    static void gradient(QRgb *colors, int count, quint32 phase, quint32 step, QRgb from, QRgb to);
+
+    /**
+     * @brief Fills colors with one color whose brightness follows a shape.
+     * @param colors The colors to write.
+     * @param count The number of colors.
+     * @param phase The position of the first color in the cycle.
+     * @param step The difference in position between neighbouring colors; 0 gives every color the same brightness.
+     * @param color The color at full brightness.
+     * @param shape The shape of the brightness over a cycle.
+     */
+    static void wave(QRgb *colors, int count, quint32 phase, quint32 step, QRgb color, Shape shape);
+
+    /**
+     * @brief Fills colors with one color flashing up at random moments.
+     * @details Each LED is offset in the cycle by a hash of its position and is lit for a quarter of the cycle, brightening and fading linearly.
+     * @param colors The colors to write.
+     * @param count The number of colors.
+     * @param first The position of the first color in the whole frame.
+     * @param phase The position in the cycle shared by all LEDs.
+     * @param color The color at full brightness.
+     */
+    static void twinkle(QRgb *colors, int count, int first, quint32 phase, QRgb color);
+
+    /**
+     * @brief Fills colors with flickering fire.
+     * @details Each LED gets a random heat per tick, blended linearly into the heat of the next tick, and mapped from dark red through orange to yellow.
+     * @param colors The colors to write.
+     * @param count The number of colors.
+     * @param first The position of the first color in the whole frame.
+     * @param tick The number of the current tick.
+     * @param fraction How far the frame is into the tick, from 0 to 256.
+     */
+    static void fire(QRgb *colors, int count, int first, quint32 tick, int fraction);
+
+};
+
+#endif // EFFECTKERNELS_H
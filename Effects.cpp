@@ -0,0 +1,172 @@
+/**
+ * @file Effects.cpp
+ * @brief Implementation of the Effects class.
+ * @details This file contains the built-in effects and the factory creating them. Every effect derives the phase of the first LED of its range from the frame time, so the ranges rendered by different threads line up into one continuous pattern.
+ * @see Effects.h for the declaration of the Effects class.
+ * @author Group 3
+ */
+
+#include "include/models/Effects.h"
+#include "include/utils/EffectKernels.h"
+
+namespace {
+
+/**
+ * @brief Base of the effects that repeat over time and along the strip.
+ * @details Holds the shared parameters and turns them into phases: the time phase advances by one turn per period, and neighbouring LEDs are a turn apart per length.
+ */
+class CyclicEffect : public Effect {
+
+public:
+
+    CyclicEffect(const QString &name, const Effects::Parameters &parameters)
+        : effectName(name), parameters(parameters), step(quint32((quint64(1) << 32) / quint64(qMax(1, parameters.length)))) {}
+
+    QString name() const override {
+        return effectName;
+    }
+
+protected:
+
+    const QString effectName; // Name the effect was created with.
+    const Effects::Parameters parameters; // Parameters the effect was created with.
+    const quint32 step; // Phase difference between neighbouring LEDs.
+
+    /**
+     * @brief Gets how far the current cycle has progressed.
+     * @param time The time of the frame in milliseconds.
+     * @return The phase of the time within its cycle.
+     */
+    quint32 cycle(qint64 time) const {
+        const qint64 period = qMax(1, parameters.period);
+        return quint32((quint64(time % period) << 32) / quint64(period));
+    }
+
+    /**
+     * @brief Gets the phase of the first LED of a range, for a pattern travelling along the strip.
+     * @details Subtracting the time phase moves every phase value towards higher positions as time goes on.
+     * @param context The frame being rendered.
+     * @param first The display position of the first LED.
+     * @return The phase of the LED.
+     */
+    quint32 travelling(const Effect::Context &context, int first) const {
+        return quint32(first) * step - cycle(context.time);
+    }
+
+};
+
+/**
+ * @brief Lit segments with fading tails running along the strip.
+ */
+class ChaseEffect : public CyclicEffect {
+public:
+    using CyclicEffect::CyclicEffect;
+    void render(const Context &context, QRgb *colors, int first, int count) const override {
+        EffectKernels::wave(colors + first, count, travelling(context, first), step, parameters.color, EffectKernels::Pulse);
+    }
+};
+
+/**
+ * @brief Smooth bands of brightness running along the strip.
+ */
+class WaveEffect : public CyclicEffect {
+public:
+    using CyclicEffect::CyclicEffect;
+    void render(const Context &context, QRgb *colors, int first, int count) const override {
+        EffectKernels::wave(colors + first, count, travelling(context, first), step, parameters.color, EffectKernels::Sine);
+    }
+};
+
+/**
+ * @brief Every LED fading in and out together.
+ */
+class BreatheEffect : public CyclicEffect {
+public:
+    using CyclicEffect::CyclicEffect;
+    void render(const Context &context, QRgb *colors, int first, int count) const override {
+        EffectKernels::wave(colors + first, count, cycle(context.time), 0, parameters.color, EffectKernels::Sine);
+    }
+};
+
+/**
+ * @brief The color wheel spread along the strip and running along it.
+ */
+class RainbowEffect : public CyclicEffect {
+public:
+    using CyclicEffect::CyclicEffect;
+    void render(const Context &context, QRgb *colors, int first, int count) const override {
+        EffectKernels::hueRamp(colors + first, count, travelling(context, first), step);
+    }
+};
+
+/**
+ * @brief LEDs flashing up at random moments.
+ */
+class TwinkleEffect : public CyclicEffect {
+public:
+    using CyclicEffect::CyclicEffect;
+    void render(const Context &context, QRgb *colors, int first, int count) const override {
+        EffectKernels::twinkle(colors + first, count, first, cycle(context.time), parameters.color);
+    }
+};
+
+/**
+ * @brief Flickering flames.
+ * @details The flames change sixteen times per period, blending smoothly from one tick to the next.
+ */
+class FireEffect : public CyclicEffect {
+public:
+    using CyclicEffect::CyclicEffect;
+    void render(const Context &context, QRgb *colors, int first, int count) const override {
+        const qint64 tickLength = qMax(1, parameters.period / 16);
+        const int fraction = int((context.time % tickLength) * 256 / tickLength);
+        EffectKernels::fire(colors + first, count, first, quint32(context.time / tickLength), fraction);
+    }
+};
+
+/**
+ * @brief A blend from the main color to the second color and back, sweeping along the strip.
+ */
+class GradientEffect : public CyclicEffect {
+public:
+    using CyclicEffect::CyclicEffect;
+    void render(const Context &context, QRgb *colors, int first, int count) const override {
+        EffectKernels::gradient(colors + first, count, travelling(context, first), step, parameters.color, parameters.secondColor);
+    }
+};
+
+}
+
+/**
+ * @brief Gets the names of the effects.
+ * @return The names.
+ */
+QStringList Effects::names() {
+    return {"chase", "wave", "breathe", "rainbow", "twinkle", "fire", "gradient"};
+}
+
+/**
+ * @brief Creates an effect.
+ * @param name The name of the effect.
+ * @param parameters The parameters of the effect.
+ * @return The effect, or nullptr if the name is unknown.
+ */
+QSharedPointer<const Effect> Effects::create(const QString &name, const Parameters &parameters) {
+    if (name == "chase") {return QSharedPointer<const Effect>(new ChaseEffect(name, parameters));}
+    if (name == "wave") {return QSharedPointer<const Effect>(new WaveEffect(name, parameters));}
+    if (name == "breathe") {return QSharedPointer<const Effect>(new BreatheEffect(name, parameters));}
+    if (name == "rainbow") {return QSharedPointer<const Effect>(new RainbowEffect(name, parameters));}
+    if (name == "twinkle") {return QSharedPointer<const Effect>(new TwinkleEffect(name, parameters));}
+    if (name == "fire") {return QSharedPointer<const Effect>(new FireEffect(name, parameters));}
+    if (name == "gradient") {return QSharedPointer<const Effect>(new GradientEffect(name, parameters));}
+    return nullptr;
+}
+
+/**
+ * @brief Creates an effect with the default parameters.
+ * @param name The name of the effect.
+ * @return The effect, or nullptr if the name is unknown.
+ */
+QSharedPointer<const Effect> Effects::create(const QString &name) {
+    return create(name, Parameters());
+}
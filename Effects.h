@@ -0,0 +1,61 @@
+/**
+ * @file Effects.h
+ * @brief Defines the Effects class, the library of built-in animation effects.
+ * @details This header file contains the declaration of the Effects class, which creates the effects the interfaces offer by name. Each effect is a thin layer that turns the frame time and its parameters into phases for one of the EffectKernels.
+ * @author Group 3
+ */
+
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include "include/models/Effect.h"
+
+// Including necessary modules.
+#include <QSharedPointer>
+#include <QStringList>
+
+/**
+ * @class Effects
+ * @brief Creates built-in effects by name.
+ * @details The effects are chase, wave, breathe, rainbow, twinkle, fire and gradient. Effects that travel along the strip move towards higher display positions.
+ * @author Group 3
+ */
+class Effects {
+
+public:
+
+    /**
+     * @brief Parameters shared by the effects.
+     * @details Each effect uses the parameters that make sense for it and ignores the others.
+     */
+    struct Parameters {
+        QRgb color = 0xffffffff; ///< Main color, used by chase, wave, breathe, twinkle and gradient.
+        QRgb secondColor = 0xff0000ff; ///< Second color, used by gradient.
+        int period = 2000; ///< Duration of one cycle in milliseconds; fire changes its flames sixteen times per cycle.
+        int length = 64; ///< Number of LEDs in one cycle along the strip, used by chase, wave, rainbow and gradient.
+    };
+
+    /**
+     * @brief Gets the names of the effects.
+     * @return QStringList The names, in the order the interfaces list them.
+     */
+    static QStringList names();
+
+    /**
+     * @brief Creates an effect.
+     * @param name The name of the effect, as returned by names().
+     * @param parameters The parameters of the effect. The period and length are raised to at least 1.
+     * @return QSharedPointer<const Effect> The effect, or nullptr if the name is unknown.
+     */
+    static QSharedPointer<const Effect> create(const QString &name, const Parameters &parameters);
+
+    /**
+     * @brief Creates an effect with the default parameters.
+     * @param name The name of the effect, as returned by names().
+     * @return QSharedPointer<const Effect> The effect, or nullptr if the name is unknown.
+     */
+    static QSharedPointer<const Effect> create(const QString &name);
+
+};
+
+#endif // EFFECTS_H
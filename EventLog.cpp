@@ -0,0 +1,319 @@
+/**
+ * @file EventLog.cpp
+ * @brief Implementation of the EventLog class.
+ * @details This file contains the implementation of the EventLog class: the table of event levels and formats, the bounded lock-free ring buffer the records pass through, and the background thread that formats and writes them. The ring buffer follows the bounded multi-producer queue design in which every cell carries a sequence number, so producers only contend on one atomic counter and the single consumer needs no atomic read-modify-write at all.
+ * @see EventLog.h for the declaration of the EventLog class.
+ * @author Group 3
+ */
+
+#include "include/utils/EventLog.h"
+
+// Including necessary modules.
+#include <QAtomicInteger>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QString>
+#include <QThread>
+#include <cstdio>
+
+namespace {
+
+/**
+ * @brief Level and message format of one kind of event.
+ */
+struct EventInfo {
+    EventLog::Level level; // Level of the event.
+    const char *format; // Message, with %1 and %2 standing for the arguments.
+    int arguments; // Number of arguments used by the message.
+    bool colorArgument; // True if the second argument is an RGB value.
+};
+
+// Indexed by EventLog::Event.
+const EventInfo Events[] = {
+    {EventLog::Debug, "LED #%1 added.", 1, false},
+    {EventLog::Debug, "LED #%1 removed.", 1, false},
+    {EventLog::Debug, "LED #%1 turned on.", 1, false},
+    {EventLog::Debug, "LED #%1 turned off.", 1, false},
+    {EventLog::Debug, "LED #%1 turned off after its duration ended.", 1, false},
+    {EventLog::Debug, "LED #%1 color changed to %2.", 2, true},
+    {EventLog::Debug, "LED #%1 blinking speed set to %2 ms.", 2, false},
+    {EventLog::Debug, "LED #%1 duration set to %2 seconds.", 2, false},
+    {EventLog::Info, "%1 LED(s) added.", 1, false},
+    {EventLog::Info, "%1 LED(s) removed.", 1, false},
+    {EventLog::Info, "%1 LED(s) turned on.", 1, false},
+    {EventLog::Info, "%1 LED(s) turned off.", 1, false},
+    {EventLog::Info, "%1 LED(s) turned off after their duration ended.", 1, false},
+    {EventLog::Info, "Changed color of %1 on LED(s) to %2.", 2, true},
+    {EventLog::Info, "Blinking speed set for %1 on LED(s) to %2 ms.", 2, false},
+    {EventLog::Info, "Duration set for %1 on LED(s) to %2 seconds.", 2, false},
+    {EventLog::Info, "All LEDs have been removed.", 0, false},
+    {EventLog::Info, "Help button clicked.", 0, false},
+    {EventLog::Warning, "No LEDs available to turn on.", 0, false},
+    {EventLog::Warning, "All LEDs were already on.", 0, false},
+    {EventLog::Warning, "No LEDs available to turn off.", 0, false},
+    {EventLog::Warning, "All LEDs were already off.", 0, false},
+    {EventLog::Warning, "No LEDs available to remove.", 0, false},
+    {EventLog::Warning, "No LEDs are off, nothing to remove.", 0, false},
+    {EventLog::Warning, "LED capacity reached, can't add LEDs.", 0, false},
+    {EventLog::Warning, "No LEDs available to change color.", 0, false},
+    {EventLog::Warning, "No LEDs are on, can't change colors.", 0, false},
+    {EventLog::Warning, "No LEDs available to set blinking speed.", 0, false},
+    {EventLog::Warning, "No LEDs are on, can't set blinking speed.", 0, false},
+    {EventLog::Warning, "No LEDs available to set duration.", 0, false},
+    {EventLog::Warning, "No LEDs are on, can't set duration.", 0, false},
+};
+static_assert(sizeof(Events) / sizeof(Events[0]) == EventLog::EventCount, "Every event needs an entry in the event table.");
+
+const char *const LevelNames[] = {"debug", "info", "warning"}; // Indexed by EventLog::Level.
+
+/**
+ * @brief One fixed-size log record.
+ */
+struct Record {
+    qint64 time; // Microseconds since the log was created.
+    qint64 first; // First argument.
+    qint64 second; // Second argument.
+    int event; // EventLog::Event of the record.
+};
+
+/**
+ * @brief Cell of the ring buffer.
+ * @details The sequence tells producers and the consumer whose turn it is: it equals the position for a free cell and the position plus one for a filled one.
+ */
+struct Cell {
+    QAtomicInteger<quint64> sequence;
+    Record record;
+};
+
+const int Capacity = 1 << 14; // Number of cells; must be a power of two.
+
+/**
+ * @brief Bounded ring buffer of records with many producers and one consumer.
+ */
+struct Ring {
+
+    Cell cells[Capacity];
+    QAtomicInteger<quint64> head; // Next position to be claimed by a producer.
+    quint64 tail = 0; // Next position to be read by the consumer.
+    QElapsedTimer clock; // Clock the record times are measured against.
+
+    Ring() : head(0) {
+        for (int i = 0; i < Capacity; ++i) {cells[i].sequence.storeRelaxed(quint64(i));}
+        clock.start();
+    }
+
+    /**
+     * @brief Appends a record unless the buffer is full.
+     * @param record The record to append.
+     * @return True if the record was appended.
+     */
+    bool push(const Record &record) {
+        quint64 position = head.loadRelaxed();
+        forever {
+            Cell &cell = cells[position & (Capacity - 1)];
+            const qint64 difference = qint64(cell.sequence.loadAcquire() - position);
+            if (difference == 0) {
+                if (head.testAndSetRelaxed(position, position + 1, position)) { // On failure, position is updated to the current head.
+                    cell.record = record;
+                    cell.sequence.storeRelease(position + 1);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // The consumer has not caught up with this cell yet.
+            } else {
+                position = head.loadRelaxed(); // Another producer claimed this cell.
+            }
+        }
+    }
+
+    /**
+     * @brief Takes the oldest record if there is one.
+     * @details Must only be called from one thread at a time.
+     * @param record Receives the record.
+     * @return True if a record was taken.
+     */
+    bool pop(Record &record) {
+        Cell &cell = cells[tail & (Capacity - 1)];
+        if (cell.sequence.loadAcquire() != tail + 1) {return false;}
+        record = cell.record;
+        cell.sequence.storeRelease(tail + Capacity);
+        ++tail;
+        return true;
+    }
+
+};
+
+Ring ring; // Ring buffer shared by all threads.
+QAtomicInt threshold(EventLog::Debug); // Lowest level that is logged.
+QAtomicInt aggregation(1); // 1 if batched records are aggregated.
+QAtomicInteger<quint64> dropped(0); // Number of records lost because the buffer was full.
+quint64 reportedDrops = 0; // Dropped records already reported by the consumer.
+thread_local EventLog::Batch *currentBatch = nullptr; // Innermost open batch of the calling thread.
+
+/**
+ * @brief Formats one record as a line of text.
+ * @param record The record to format.
+ * @param out Buffer receiving the line.
+ */
+void format(const Record &record, QByteArray &out) {
+    const EventInfo &info = Events[record.event];
+    QString message = QString::fromLatin1(info.format);
+    if (info.arguments >= 1) {message = message.arg(record.first);}
+    if (info.arguments >= 2) {
+        if (info.colorArgument) {message = message.arg(QString("#%1").arg(record.second & 0xffffff, 6, 16, QLatin1Char('0')));}
+        else {message = message.arg(record.second);}
+    }
+    out += QString("[%1] %2: ").arg(record.time / 1e6, 10, 'f', 3).arg(QLatin1String(LevelNames[info.level])).toLatin1();
+    out += message.toUtf8();
+    out += '\n';
+}
+
+/**
+ * @brief Formats and writes every record currently in the ring buffer.
+ * @details Lines are collected in one buffer and written with a single call.
+ * @return True if anything was written.
+ */
+bool drain() {
+
+    QByteArray out;
+    Record record;
+    while (ring.pop(record)) {format(record, out);}
+
+    const quint64 lost = dropped.loadRelaxed();
+    if (lost != reportedDrops) {
+        out += QString("%1 log record(s) dropped.\n").arg(lost - reportedDrops).toLatin1();
+        reportedDrops = lost;
+    }
+
+    if (out.isEmpty()) {return false;}
+    std::fwrite(out.constData(), 1, size_t(out.size()), stderr);
+    std::fflush(stderr);
+    return true;
+
+}
+
+/**
+ * @brief Background thread consuming the ring buffer.
+ * @details Polls the buffer and sleeps briefly whenever it is empty, so producers never have to wake it.
+ */
+class Writer : public QThread {
+
+public:
+
+    QAtomicInt stopping{0}; // Set to 1 to make the thread finish.
+
+protected:
+
+    void run() override {
+        while (!stopping.loadAcquire()) {
+            if (!drain()) {msleep(10);}
+        }
+        drain();
+    }
+
+};
+
+Writer *writer = nullptr; // Running writer thread, if any.
+
+}
+
+/**
+ * @brief Opens a batch.
+ * @details The batch becomes the innermost one of the calling thread.
+ * @param summary The event recorded when the batch closes.
+ * @param value The second argument of the summary record.
+ */
+EventLog::Batch::Batch(Event summary, qint64 value) : outer(currentBatch), summary(summary), value(value) {
+    currentBatch = this;
+}
+
+/**
+ * @brief Closes the batch and records its summary.
+ * @details The summary is recorded after the batch is closed, so it counts as one record of an enclosing batch, if any.
+ */
+EventLog::Batch::~Batch() {
+    currentBatch = outer;
+    record(summary, count, value);
+}
+
+/**
+ * @brief Starts the background writer thread.
+ */
+void EventLog::start() {
+    if (writer) {return;}
+    writer = new Writer;
+    writer->start(QThread::LowPriority);
+}
+
+/**
+ * @brief Stops the background writer thread.
+ * @details The thread drains the buffer once more before it finishes.
+ */
+void EventLog::stop() {
+    if (!writer) {return;}
+    writer->stopping.storeRelease(1);
+    writer->wait();
+    delete writer;
+    writer = nullptr;
+}
+
+/**
+ * @brief Sets the lowest level that is logged.
+ * @param level The threshold.
+ */
+void EventLog::setLevel(Level level) {
+    threshold.storeRelaxed(level);
+}
+
+/**
+ * @brief Gets the lowest level that is logged.
+ * @return The current threshold.
+ */
+EventLog::Level EventLog::level() {
+    return Level(threshold.loadRelaxed());
+}
+
+/**
+ * @brief Enables or disables aggregation of batched records.
+ * @param enabled True to collapse each batch into its summary record.
+ */
+void EventLog::setAggregation(bool enabled) {
+    aggregation.storeRelaxed(enabled ? 1 : 0);
+}
+
+/**
+ * @brief Checks if batched records are aggregated.
+ * @return True if each batch is collapsed into its summary record.
+ */
+bool EventLog::isAggregating() {
+    return aggregation.loadRelaxed() != 0;
+}
+
+/**
+ * @brief Records an event.
+ * @details The batch count is taken before the level check, so summaries report the number of affected LEDs even when per-LED events are not logged.
+ * @param event The kind of event.
+ * @param first The first argument of the event's message.
+ * @param second The second argument of the event's message.
+ */
+void EventLog::record(Event event, qint64 first, qint64 second) {
+
+    if (currentBatch) {
+        ++currentBatch->count;
+        if (aggregation.loadRelaxed()) {return;} // Only the batch's summary is written.
+    }
+
+    if (Events[event].level < threshold.loadRelaxed()) {return;}
+
+    const Record entry = {ring.clock.nsecsElapsed() / 1000, first, second, event};
+    if (!ring.push(entry)) {dropped.fetchAndAddRelaxed(1);}
+
+}
+
+/**
+ * @brief Gets the number of records lost because the ring buffer was full.
+ * @return The total number of dropped records.
+ */
+quint64 EventLog::droppedCount() {
+    return dropped.loadRelaxed();
+}
@@ -0,0 +1,162 @@
+/**
+ * @file EventLog.h
+ * @brief Defines the EventLog class, an asynchronous structured log for LED events.
+ * @details This header file contains the declaration of the EventLog class. Callers record fixed-size binary records into a lock-free ring buffer, and a background thread formats them and writes them to standard error in batches. Recording therefore never blocks on output, which matters when a bulk operation touches tens of thousands of LEDs.
+ * @author Group 3
+ */
+
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+// Including necessary modules.
+#include <QtGlobal>
+
+/**
+ * @class EventLog
+ * @brief Process-wide asynchronous event log.
+ * @details Every event has a fixed level and message format, so a record only holds the event code, a timestamp and two integer arguments. Records below the configured level are discarded at the call site. Any thread may record; records are lost, and counted as dropped, only if the ring buffer is full. A Batch groups the per-LED records of one bulk operation: in aggregation mode they are only counted, and the batch leaves a single summary record behind.
+ * @author Group 3
+ */
+class EventLog {
+
+public:
+
+    /**
+     * @brief Severity of an event.
+     */
+    enum Level {
+        Debug, ///< Per-LED events.
+        Info, ///< Summaries of user actions.
+        Warning, ///< Actions that could not be carried out.
+        Off ///< Used as threshold only: nothing is logged.
+    };
+
+    /**
+     * @brief Kinds of events that can be recorded.
+     * @details The first argument of a per-LED event is the LED's display number. The first argument of a summary event is the number of LEDs affected.
+     */
+    enum Event {
+        LedAdded, ///< An LED was added.
+        LedRemoved, ///< An LED was removed.
+        LedTurnedOn, ///< An LED was turned on.
+        LedTurnedOff, ///< An LED was turned off.
+        LedExpired, ///< An LED was turned off because its duration ran out.
+        LedColorChanged, ///< An LED changed color; the second argument is the RGB value.
+        LedBlinkSpeedSet, ///< An LED's blink speed was set; the second argument is the speed in milliseconds.
+        LedDurationSet, ///< An LED's duration was set; the second argument is the duration in seconds.
+        LedsAdded, ///< Summary of LedAdded.
+        LedsRemoved, ///< Summary of LedRemoved.
+        LedsTurnedOn, ///< Summary of LedTurnedOn.
+        LedsTurnedOff, ///< Summary of LedTurnedOff.
+        LedsExpired, ///< Summary of LedExpired.
+        LedsColorChanged, ///< Summary of LedColorChanged; the second argument is the RGB value.
+        LedsBlinkSpeedSet, ///< Summary of LedBlinkSpeedSet; the second argument is the speed in milliseconds.
+        LedsDurationSet, ///< Summary of LedDurationSet; the second argument is the duration in seconds.
+        AllLedsRemoved, ///< Every LED was removed at once.
+        HelpOpened, ///< The help dialog was opened.
+        NothingToTurnOn, ///< Turning all LEDs on failed because there are none.
+        AllAlreadyOn, ///< Turning all LEDs on had no effect.
+        NothingToTurnOff, ///< Turning all LEDs off failed because there are none.
+        AllAlreadyOff, ///< Turning all LEDs off had no effect.
+        NothingToRemove, ///< Removing all LEDs failed because there are none.
+        NoLedsOff, ///< Removing the LEDs that are off failed because none are off.
+        CapacityReached, ///< Adding LEDs failed because the store is full.
+        NothingToColor, ///< Changing all colors failed because there are no LEDs.
+        NoneOnToColor, ///< Changing all colors failed because no LED is on.
+        NothingToBlink, ///< Setting all blink speeds failed because there are no LEDs.
+        NoneOnToBlink, ///< Setting all blink speeds failed because no LED is on.
+        NothingToTime, ///< Setting all durations failed because there are no LEDs.
+        NoneOnToTime, ///< Setting all durations failed because no LED is on.
+        EventCount ///< Number of event kinds.
+    };
+
+    /**
+     * @class Batch
+     * @brief Scope grouping the per-LED records of one bulk operation.
+     * @details While a batch is open on a thread, every record made on that thread is counted. In aggregation mode the records are not written at all. When the batch closes, it records its summary event with the count as first argument, so a bulk operation produces exactly one record in aggregation mode.
+     * @author Group 3
+     */
+    class Batch {
+
+    public:
+
+        /**
+         * @brief Opens a batch.
+         * @param summary The event recorded when the batch closes.
+         * @param value The second argument of the summary record.
+         */
+        explicit Batch(Event summary, qint64 value = 0);
+
+        /**
+         * @brief Closes the batch and records its summary.
+         */
+        ~Batch();
+
+    private:
+
+        friend class EventLog;
+
+        Batch *outer; // Batch that was open on this thread before this one.
+        Event summary; // Event recorded when the batch closes.
+        qint64 value; // Second argument of the summary record.
+        qint64 count = 0; // Number of records made while the batch was open.
+
+        Q_DISABLE_COPY(Batch)
+
+    };
+
+    /**
+     * @brief Starts the background writer thread.
+     * @details Records made before the call are kept in the ring buffer and written once the thread runs.
+     */
+    static void start();
+
+    /**
+     * @brief Stops the background writer thread.
+     * @details Writes every record still in the ring buffer before returning.
+     */
+    static void stop();
+
+    /**
+     * @brief Sets the lowest level that is logged.
+     * @param level The threshold. Off discards every record.
+     */
+    static void setLevel(Level level);
+
+    /**
+     * @brief Gets the lowest level that is logged.
+     * @return Level The current threshold.
+     */
+    static Level level();
+
+    /**
+     * @brief Enables or disables aggregation of batched records.
+     * @details Aggregation is on by default.
+     * @param enabled True to collapse each batch into its summary record, false to also write every record made inside a batch.
+     */
+    static void setAggregation(bool enabled);
+
+    /**
+     * @brief Checks if batched records are aggregated.
+     * @return bool True if each batch is collapsed into its summary record.
+     */
+    static bool isAggregating();
+
+    /**
+     * @brief Records an event.
+     * @details Costs a few atomic operations and never blocks. Inside a batch in aggregation mode, it only increments the batch's count.
+     * @param event The kind of event.
+     * @param first The first argument of the event's message.
+     * @param second The second argument of the event's message.
+     */
+    static void record(Event event, qint64 first = 0, qint64 second = 0);
+
+    /**
+     * @brief Gets the number of records lost because the ring buffer was full.
+     * @return quint64 The total number of dropped records.
+     */
+    static quint64 droppedCount();
+
+};
+
+#endif // EVENTLOG_H
@@ -0,0 +1,91 @@
+/**
+ * @file FrameStats.cpp
+ * @brief Implementation of the FrameStats class.
+ * @details This file contains the implementation of the FrameStats class. Percentiles are computed with partial sorting once per measuring period, never while painting.
+ * @see FrameStats.h for the declaration of the FrameStats class.
+ * @author Group 3
+ */
+
+#include "include/utils/FrameStats.h"
+
+// Including necessary modules.
+#include <algorithm>
+
+/**
+ * @brief Starts measuring a paint.
+ * @param stats The statistics to record the paint in, or nullptr.
+ */
+FrameStats::PaintScope::PaintScope(FrameStats *stats) : stats(stats) {
+    if (stats) {timer.start();}
+}
+
+/**
+ * @brief Records the duration of the paint.
+ */
+FrameStats::PaintScope::~PaintScope() {
+    if (stats) {stats->addPaint(timer.nsecsElapsed());}
+}
+
+/**
+ * @brief Constructs a FrameStats.
+ */
+FrameStats::FrameStats() {
+    samples.reserve(SampleLimit);
+    sorted.reserve(SampleLimit);
+}
+
+/**
+ * @brief Records one paint.
+ * @details Once the buffer is full, the oldest duration is overwritten.
+ * @param nanoseconds The duration of the paint.
+ */
+void FrameStats::addPaint(qint64 nanoseconds) {
+    if (samples.size() < SampleLimit) {samples.append(nanoseconds);}
+    else {samples[paints % SampleLimit] = nanoseconds;}
+    ++paints;
+}
+
+/**
+ * @brief Records one layout pass.
+ */
+void FrameStats::addLayout() {
+    ++layouts;
+}
+
+/**
+ * @brief Records the area painted by one paint.
+ * @param count The number of pixels in the exposed region.
+ */
+void FrameStats::addPixels(qint64 count) {
+    pixels += count;
+}
+
+/**
+ * @brief Summarizes the current measuring period and starts a new one.
+ * @details Each percentile is found with nth_element on a copy of the samples, which is linear in their number.
+ * @return The summary of the period that ended. The percentiles are 0 if nothing was painted.
+ */
+FrameStats::Summary FrameStats::take() {
+
+    Summary summary = {paints, layouts, 0, 0, 0, pixels};
+
+    if (!samples.isEmpty()) {
+        sorted = samples;
+        const int count = sorted.size();
+        auto percentile = [this, count](int percent) {
+            auto nth = sorted.begin() + qMin(count - 1, count * percent / 100);
+            std::nth_element(sorted.begin(), nth, sorted.end());
+            return *nth;
+        };
+        summary.p50 = percentile(50);
+        summary.p95 = percentile(95);
+        summary.p99 = percentile(99);
+    }
+
+    samples.clear();
+    paints = 0;
+    layouts = 0;
+    pixels = 0;
+    return summary;
+
+}
@@ -0,0 +1,112 @@
+/**
+ * @file FrameStats.h
+ * @brief Defines the FrameStats class, which collects paint and layout timings for the performance overlay.
+ * @details This header file contains the declaration of the FrameStats class. It is only built when PILLUMINATE_PERF_OVERLAY is defined, which the project file does unless qmake is run with CONFIG+=no_perf_overlay.
+ * @author Group 3
+ */
+
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+// Including necessary modules.
+#include <QElapsedTimer>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @class FrameStats
+ * @brief Counts paints and layout passes and keeps the paint durations of one measuring period.
+ * @details Recording a paint costs one clock read at each end and one store into a preallocated buffer, so the view can be measured without changing its behavior noticeably. take() summarizes the period and starts the next one. Only the most recent SampleLimit durations of a period are kept, which bounds the memory and the cost of computing percentiles.
+ * @author Group 3
+ */
+class FrameStats {
+
+public:
+
+    /**
+     * @brief Summary of one measuring period.
+     */
+    struct Summary {
+        int paints; ///< Number of paints.
+        int layouts; ///< Number of layout passes.
+        qint64 p50; ///< Median paint duration in nanoseconds.
+        qint64 p95; ///< 95th percentile of the paint durations in nanoseconds.
+        qint64 p99; ///< 99th percentile of the paint durations in nanoseconds.
+        qint64 pixels; ///< Number of pixels painted, summed over the paints.
+    };
+
+    /**
+     * @class PaintScope
+     * @brief Measures the paint that runs while it exists.
+     * @details Does nothing if constructed without FrameStats, so the view pays a single branch while no overlay is shown.
+     * @author Group 3
+     */
+    class PaintScope {
+
+    public:
+
+        /**
+         * @brief Starts measuring a paint.
+         * @param stats The statistics to record the paint in, or nullptr to measure nothing.
+         */
+        explicit PaintScope(FrameStats *stats);
+
+        /**
+         * @brief Records the duration of the paint.
+         */
+        ~PaintScope();
+
+    private:
+
+        FrameStats *stats; // Statistics receiving the paint, if any.
+        QElapsedTimer timer; // Clock started with the paint.
+
+        Q_DISABLE_COPY(PaintScope)
+
+    };
+
+    /**
+     * @brief Constructor for FrameStats.
+     * @details Allocates the sample buffer up front, so recording never allocates.
+     */
+    FrameStats();
+
+    /**
+     * @brief Records one paint.
+     * @param nanoseconds The duration of the paint.
+     */
+    void addPaint(qint64 nanoseconds);
+
+    /**
+     * @brief Records one layout pass.
+     */
+    void addLayout();
+
+    /**
+     * @brief Records the area painted by one paint.
+     * @param count The number of pixels in the exposed region, in device-independent pixels, as counted by LedMatrixView::lastFramePixels().
+     */
+    void addPixels(qint64 count);
+
+    /**
+     * @brief Summarizes the current measuring period and starts a new one.
+     * @return Summary The counts and paint percentiles of the period that ended.
+     */
+    Summary take();
+
+    /**
+     * @brief Maximum number of paint durations kept per period.
+     */
+    static const int SampleLimit = 1024;
+
+private:
+
+    QVector<qint64> samples; // Paint durations of the current period, used as a ring once full.
+    QVector<qint64> sorted; // Scratch buffer for computing percentiles.
+    int paints = 0; // Paints in the current period.
+    int layouts = 0; // Layout passes in the current period.
+    qint64 pixels = 0; // Pixels painted in the current period.
+
+};
+
+#endif // FRAMESTATS_H
@@ -0,0 +1,421 @@
+/**
+ * @file LedController.cpp
+ * @brief Implementation of the LedController class.
+ * @details This file contains the implementation of the LedController class: the bulk operations, which write the store's arrays in one pass and log one batch each, the operations on single LEDs, and the wiring of the schedulers and the effect engine.
+ * @see LedController.h for the declaration of the LedController class.
+ * @author Group 3
+ */
+
+#include "include/models/LedController.h"
+#include "include/utils/EventLog.h"
+#include "include/utils/Trace.h"
+
+/**
+ * @brief Constructs a LedController.
+ * @details Blink ticks and expired durations are forwarded as ledsChanged(), so that a frontend has one signal to repaint or ignore.
+ * @param parent The parent object.
+ */
+LedController::LedController(QObject *parent) : QObject(parent), output(store) {
+    blinkScheduler = new BlinkScheduler(&store, this);
+    connect(blinkScheduler, &BlinkScheduler::phasesChanged, this, &LedController::ledsChanged);
+    durationScheduler = new DurationScheduler(&store, this);
+    connect(durationScheduler, &DurationScheduler::ledsExpired, this, &LedController::ledsChanged);
+    effectEngine = new EffectEngine(this);
+    connect(effectEngine, &EffectEngine::frameReady, this, &LedController::applyEffectFrame);
+}
+
+/**
+ * @brief Gives read access to the state of the LEDs.
+ * @return The store holding every LED.
+ */
+const LedStore &LedController::ledStore() const {
+    return store;
+}
+
+/**
+ * @brief Gives access to the colors the LEDs output.
+ * @return The output frame of the store.
+ */
+OutputFrame &LedController::outputFrame() {
+    return output;
+}
+
+/**
+ * @brief Adds LEDs at the end of the display order.
+ * @details Slots freed by earlier removals are reused first. The capacity is checked here, so that no frontend can fill the store beyond what a handle can address; the loops still stop at a failed append().
+ * @param count The number of LEDs to add.
+ * @return Done, or Full.
+ */
+LedController::Result LedController::addLeds(int count) {
+
+    Trace::Span span("LedController::addLeds");
+
+    if (count <= 0) {return Done;}
+
+    if (count > LedStore::MaxSlots - store.size()) {
+        EventLog::record(EventLog::CapacityReached);
+        return Full;
+    }
+
+    if (count == 1) { // A single LED is logged on its own rather than as a batch.
+        if (store.append() >= 0) {EventLog::record(EventLog::LedAdded, store.size());}
+    } else {
+        EventLog::Batch batch(EventLog::LedsAdded); // One log record for the whole batch.
+        if (count > store.slotCount()) {store.reserve(qMin(store.slotCount() + count, LedStore::MaxSlots));} // Allocating storage for a large batch at once; small batches grow geometrically.
+        for (int i = 0; i < count && store.append() >= 0; ++i) {
+            EventLog::record(EventLog::LedAdded, store.size()); // New LEDs go to the end of the display order.
+        }
+    }
+    return Done;
+
+}
+
+/**
+ * @brief Removes every LED.
+ * @details Handles of the removed LEDs become stale.
+ * @return Done, or NoLeds.
+ */
+LedController::Result LedController::removeAll() {
+
+    Trace::Span span("LedController::removeAll");
+
+    if (store.isEmpty()) {
+        EventLog::record(EventLog::NothingToRemove);
+        return NoLeds;
+    }
+
+    store.clear();
+    durationScheduler->reschedule(); // No deadline is left.
+    EventLog::record(EventLog::AllLedsRemoved);
+    return Done;
+
+}
+
+/**
+ * @brief Removes every LED that is off.
+ * @details Free slots are off as well, so the targets are taken from the live slots.
+ * @return Done, NoLeds or NoneOff.
+ */
+LedController::Result LedController::removeOff() {
+
+    Trace::Span span("LedController::removeOff");
+
+    if (store.isEmpty()) {
+        EventLog::record(EventLog::NothingToRemove);
+        return NoLeds;
+    }
+    if (store.onCount() == store.size()) {
+        EventLog::record(EventLog::NoLedsOff);
+        return NoneOff;
+    }
+
+    QVector<int> targets;
+    const BitSet &live = store.liveBits();
+    const BitSet &on = store.onBits();
+    for (int i = live.nextSet(0); i >= 0; i = live.nextSet(i + 1)) {if (!on.test(i)) {targets.append(i);}}
+    removeSlots(targets);
+    return Done;
+
+}
+
+/**
+ * @brief Removes the LEDs in a set of slots.
+ * @details Each removal is O(1) in the store.
+ * @param targets The slots of the LEDs to remove.
+ */
+void LedController::removeSlots(const QVector<int> &targets) {
+
+    if (targets.isEmpty()) {return;}
+
+    {
+        EventLog::Batch batch(EventLog::LedsRemoved); // One log record for the whole batch.
+        for (int slot : targets) {EventLog::record(EventLog::LedRemoved, store.displayIndex(slot) + 1);}
+    }
+    for (int slot : targets) {store.remove(slot);}
+    durationScheduler->reschedule(); // Removed LEDs may have held the nearest deadline.
+
+}
+
+/**
+ * @brief Removes one LED.
+ * @details The remaining LEDs keep their handles; only the display numbers after the removed LED shift.
+ * @param slot The slot of the LED.
+ */
+void LedController::remove(int slot) {
+    EventLog::record(EventLog::LedRemoved, store.displayIndex(slot) + 1);
+    store.remove(slot);
+    durationScheduler->reschedule(); // The LED may have held the nearest deadline.
+}
+
+/**
+ * @brief Turns every LED on or off.
+ * @details Goes over the LEDs that change one by one for their colors and blink state, then writes the on/off flags of all slots at once. Free slots are always off, so writing their flags is harmless.
+ * @param state True to turn the LEDs on, false to turn them off.
+ * @return Done, NoLeds, AllOn or AllOff.
+ */
+LedController::Result LedController::turnAll(bool state) {
+
+    Trace::Span span("LedController::turnAll");
+
+    if (store.isEmpty()) {
+        EventLog::record(state ? EventLog::NothingToTurnOn : EventLog::NothingToTurnOff);
+        return NoLeds;
+    }
+    if (store.onCount() == (state ? store.size() : 0)) {
+        EventLog::record(state ? EventLog::AllAlreadyOn : EventLog::AllAlreadyOff);
+        return state ? AllOn : AllOff;
+    }
+
+    {
+        EventLog::Batch batch(state ? EventLog::LedsTurnedOn : EventLog::LedsTurnedOff); // One log record for the whole batch.
+        const BitSet &from = state ? store.liveBits() : store.onBits();
+        const BitSet &on = store.onBits();
+        for (int i = from.nextSet(0); i >= 0; i = from.nextSet(i + 1)) {
+            if (on.test(i) != state) {switchLed(i, state);} // LEDs already in that state keep their color.
+        }
+    }
+    store.setOnRange(0, store.slotCount(), state); // One word operation per 64 LEDs.
+    store.cancelAllOffDeadlines(); // LEDs turned on must not be turned off by an old duration, and LEDs turned off have none left to run out.
+    durationScheduler->reschedule();
+    return Done;
+
+}
+
+/**
+ * @brief Turns one LED on or off.
+ * @param slot The slot of the LED.
+ * @param state True to turn the LED on, false to turn it off.
+ * @return True if the LED changed.
+ */
+bool LedController::turn(int slot, bool state) {
+    if (store.isOn(slot) == state) {return false;}
+    switchLed(slot, state);
+    store.setOn(slot, state);
+    store.setOffDeadline(slot, -1); // Either way, the LED no longer has a duration.
+    durationScheduler->reschedule();
+    return true;
+}
+
+/**
+ * @brief Turns one LED on or off without touching its on/off flag or the schedulers.
+ * @details An LED turned on becomes white and an LED turned off transparent; either way it is shown in the lit phase, and an LED turned off stops blinking.
+ * @param slot The slot of the LED.
+ * @param state True to turn the LED on, false to turn it off.
+ */
+void LedController::switchLed(int slot, bool state) {
+    store.setRgba(slot, state ? LedStore::White : LedStore::Transparent);
+    if (!state) {store.setBlinkPeriod(slot, 0);} // Stop blinking.
+    store.setBlinkPhase(slot, true); // Reset blinking state.
+    EventLog::record(state ? EventLog::LedTurnedOn : EventLog::LedTurnedOff, store.displayIndex(slot) + 1);
+}
+
+/**
+ * @brief Checks that an operation on the LEDs that are on can have an effect.
+ * @param operation The operation about to be carried out.
+ * @return Done, NoLeds or NoneOn.
+ */
+LedController::Result LedController::checkOnLeds(OnLedsOperation operation) const {
+    static const EventLog::Event nothing[] = {EventLog::NothingToColor, EventLog::NothingToBlink, EventLog::NothingToTime};
+    static const EventLog::Event noneOn[] = {EventLog::NoneOnToColor, EventLog::NoneOnToBlink, EventLog::NoneOnToTime};
+    if (store.isEmpty()) {
+        EventLog::record(nothing[operation]);
+        return NoLeds;
+    }
+    if (store.onCount() == 0) {
+        EventLog::record(noneOn[operation]);
+        return NoneOn;
+    }
+    return Done;
+}
+
+/**
+ * @brief Changes the color of every LED that is on.
+ * @details Free slots are always off, so the loop needs no liveness check.
+ * @param color The new color.
+ * @return The number of LEDs that changed.
+ */
+int LedController::setOnColor(const QColor &color) {
+
+    Trace::Span span("LedController::setOnColor");
+
+    EventLog::Batch batch(EventLog::LedsColorChanged, color.rgb()); // One log record for the whole batch.
+    const QRgb rgba = color.rgba();
+    int changed = 0;
+    const BitSet &on = store.onBits();
+    for (int i = on.nextSet(0); i >= 0; i = on.nextSet(i + 1)) {
+        store.setRgba(i, rgba);
+        EventLog::record(EventLog::LedColorChanged, store.displayIndex(i) + 1, color.rgb());
+        ++changed;
+    }
+    return changed;
+
+}
+
+/**
+ * @brief Changes the color of one LED.
+ * @param slot The slot of the LED.
+ * @param color The new color.
+ */
+void LedController::setColor(int slot, const QColor &color) {
+    const bool wasOn = store.isOn(slot);
+    store.setRgba(slot, color.rgba());
+    store.setOn(slot, color != Qt::transparent); // The state follows from the color.
+    if (store.isOn(slot) && !wasOn) {EventLog::record(EventLog::LedTurnedOn, store.displayIndex(slot) + 1);}
+    if (wasOn && !store.isOn(slot)) {cancelDuration(slot);} // Turned off, so its duration has nothing left to turn off.
+    EventLog::record(EventLog::LedColorChanged, store.displayIndex(slot) + 1, color.rgb());
+}
+
+/**
+ * @brief Gives every LED of one color another color.
+ * @details Only the summary is logged, not one record per LED, since a paletted store never visits the LEDs.
+ * @param from The color to replace.
+ * @param to The new color.
+ * @return The number of LEDs that changed.
+ */
+int LedController::recolor(QRgb from, QRgb to) {
+    const int changed = store.replaceColor(from, to);
+    if (changed > 0) {EventLog::record(EventLog::LedsColorChanged, changed, qRgb(qRed(to), qGreen(to), qBlue(to)));}
+    return changed;
+}
+
+/**
+ * @brief Sets the blinking speed of every LED that is on.
+ * @details The blink scheduler derives the phases from the periods, so the phases are only reset to the lit half here.
+ * @param speed The blinking speed in milliseconds.
+ * @return The number of LEDs that changed.
+ */
+int LedController::setOnBlinkSpeed(int speed) {
+
+    Trace::Span span("LedController::setOnBlinkSpeed");
+
+    int changed = 0;
+    {
+        EventLog::Batch batch(EventLog::LedsBlinkSpeedSet, speed); // One log record for the whole batch.
+        const BitSet &on = store.onBits();
+        for (int i = on.nextSet(0); i >= 0; i = on.nextSet(i + 1)) {
+            store.setBlinkPeriod(i, speed);
+            store.setBlinkPhase(i, true);
+            EventLog::record(EventLog::LedBlinkSpeedSet, store.displayIndex(i) + 1, speed);
+            ++changed;
+        }
+    }
+    blinkScheduler->wake();
+    return changed;
+
+}
+
+/**
+ * @brief Sets the blinking speed of one LED.
+ * @details A speed of 0 shows the LED as constantly on.
+ * @param slot The slot of the LED.
+ * @param speed The blinking speed in milliseconds.
+ */
+void LedController::setBlinkSpeed(int slot, int speed) {
+    store.setBlinkPeriod(slot, speed);
+    if (speed <= 0) {store.setBlinkPhase(slot, true);}
+    EventLog::record(EventLog::LedBlinkSpeedSet, store.displayIndex(slot) + 1, speed);
+    blinkScheduler->wake();
+}
+
+/**
+ * @brief Sets how long every LED that is on stays on.
+ * @details Each deadline is an O(1) insertion into the store's timing wheel, and the single timer is aimed at the nearest one afterwards.
+ * @param seconds The duration in seconds.
+ * @return The number of LEDs that changed.
+ */
+int LedController::setOnDuration(int seconds) {
+
+    Trace::Span span("LedController::setOnDuration");
+
+    const qint64 deadline = store.now() + qint64(seconds) * 1000;
+    int changed = 0;
+    {
+        EventLog::Batch batch(EventLog::LedsDurationSet, seconds); // One log record for the whole batch.
+        const BitSet &on = store.onBits();
+        for (int i = on.nextSet(0); i >= 0 && seconds > 0; i = on.nextSet(i + 1)) {
+            store.setOffDeadline(i, deadline);
+            EventLog::record(EventLog::LedDurationSet, store.displayIndex(i) + 1, seconds);
+            ++changed;
+        }
+    }
+    durationScheduler->reschedule();
+    return changed;
+
+}
+
+/**
+ * @brief Sets how long one LED stays on.
+ * @param slot The slot of the LED.
+ * @param seconds The duration in seconds.
+ */
+void LedController::setDuration(int slot, int seconds) {
+    if (seconds > 0) {store.setOffDeadline(slot, store.now() + qint64(seconds) * 1000);}
+    EventLog::record(EventLog::LedDurationSet, store.displayIndex(slot) + 1, seconds);
+    durationScheduler->reschedule();
+}
+
+/**
+ * @brief Cancels the duration of one LED.
+ * @details Reschedules as well, so that the timer never fires for a deadline that is gone.
+ * @param slot The slot of the LED.
+ */
+void LedController::cancelDuration(int slot) {
+    store.setOffDeadline(slot, -1);
+    durationScheduler->reschedule();
+}
+
+/**
+ * @brief Starts, replaces or stops the running effect.
+ * @details The engine is told the current number of LEDs first, so that the first frame fits. Once stopped, the engine drops any frame not taken yet, and every LED is marked dirty so that the colors under the layer are shown.
+ * @param effect The effect, or nullptr.
+ */
+void LedController::setEffect(QSharedPointer<const Effect> effect) {
+    effectEngine->setLedCount(store.size());
+    effectEngine->setEffect(effect);
+    if (!effect && output.clearEffect()) {
+        store.markAllDirty();
+        emit ledsChanged();
+    }
+}
+
+/**
+ * @brief Gets the running effect.
+ * @return The effect, or nullptr.
+ */
+QSharedPointer<const Effect> LedController::effect() const {
+    return effectEngine->effect();
+}
+
+/**
+ * @brief Clears the store's dirty flags.
+ */
+void LedController::clearDirty() {
+    store.clearDirty();
+}
+
+/**
+ * @brief Copies the latest frame of the running effect into the effect layer of the output frame.
+ * @details The frame is indexed by display position. Only LEDs that are on take the colors, as the layer only shows on them, so an effect never switches an LED on; only colors that differ mark an LED dirty. The picked colors stay in the store, so changing them while an effect runs is not undone by the next frame, and they show again once the effect stops; neither does a colorful effect push the store out of palette mode. A frame rendered for a different number of LEDs is skipped; the engine is told the current number so that the next one fits. A notification that arrives after the effect stopped is ignored.
+ */
+void LedController::applyEffectFrame() {
+
+    Trace::Span span("LedController::applyEffectFrame");
+
+    if (!effectEngine->effect()) {return;} // Queued before the effect stopped.
+    effectEngine->setLedCount(store.size());
+    if (!effectEngine->takeFrame()) {return;}
+
+    const QVector<QRgb> &colors = effectEngine->frame().colors;
+    if (colors.size() != store.size()) {return;} // Rendered before LEDs were added or removed.
+
+    bool changed = false;
+    const BitSet &on = store.onBits();
+    for (int i = on.nextSet(0); i >= 0; i = on.nextSet(i + 1)) {
+        if (output.setEffectColor(i, colors.at(store.displayIndex(i)))) {
+            store.markDirty(i);
+            changed = true;
+        }
+    }
+    if (changed) {emit ledsChanged();}
+
+}
@@ -0,0 +1,248 @@
+/**
+ * @file LedController.h
+ * @brief Defines the LedController class, which carries out every operation on the LED model for both frontends.
+ * @details This header file contains the declaration of the LedController class. It owns the LED store, the output frame and the blink, duration and effect machinery, and implements the operations on them together with their logging, so that the graphical interface and the headless command interface only translate user input into calls and results into messages. Keeping one implementation of each operation is what keeps the two frontends from drifting apart.
+ * @author Group 3
+ */
+
+#ifndef LEDCONTROLLER_H
+#define LEDCONTROLLER_H
+
+#include "include/models/BlinkScheduler.h"
+#include "include/models/DurationScheduler.h"
+#include "include/models/EffectEngine.h"
+#include "include/models/LedStore.h"
+#include "include/models/OutputFrame.h"
+
+// Including necessary modules.
+#include <QColor>
+#include <QObject>
+#include <QSharedPointer>
+#include <QVector>
+
+/**
+ * @class LedController
+ * @brief The LED model and the operations on it.
+ * @details Operations on all LEDs follow the rules of the original interface: colors, blink speeds and durations are applied to the LEDs that are on, and an operation that cannot have any effect fails with a Result instead of doing nothing silently. Every operation logs through EventLog, the bulk ones as one batch, and keeps the schedulers in step, so that callers never touch the store or the schedulers themselves. Operations change the store synchronously; the caller repaints or replies afterwards. Changes that happen on their own, such as blink ticks and expired durations, are announced with ledsChanged().
+ * @author Group 3
+ */
+class LedController : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Outcome of an operation on all LEDs.
+     */
+    enum Result {
+        Done, ///< The operation was carried out.
+        NoLeds, ///< The operation failed because there are no LEDs.
+        NoneOn, ///< The operation failed because no LED is on.
+        NoneOff, ///< The operation failed because no LED is off.
+        AllOn, ///< The operation had no effect because every LED is already on.
+        AllOff, ///< The operation had no effect because every LED is already off.
+        Full ///< The operation failed because the store has no room for that many LEDs.
+    };
+
+    /**
+     * @brief Operations that apply a value to the LEDs that are on.
+     */
+    enum OnLedsOperation {
+        ColorChange, ///< Changing the color.
+        BlinkSpeedChange, ///< Setting the blink speed.
+        DurationChange ///< Setting the duration.
+    };
+
+    /**
+     * @brief Constructor for LedController.
+     * @details Creates an empty store and the schedulers. No timer or thread runs until there is something to do.
+     * @param parent The parent object.
+     */
+    explicit LedController(QObject *parent = nullptr);
+
+    /**
+     * @brief Gives read access to the state of the LEDs.
+     * @return const LedStore& The store holding every LED.
+     */
+    const LedStore &ledStore() const;
+
+    /**
+     * @brief Gives access to the colors the LEDs output.
+     * @details The frontends set the color correction and dithering through it and read the corrected colors from it.
+     * @return OutputFrame& The output frame of the store.
+     */
+    OutputFrame &outputFrame();
+
+    /**
+     * @brief Adds LEDs at the end of the display order.
+     * @details A single LED is logged on its own and larger counts as one batch. Nothing is added if the store has no room for all of them.
+     * @param count The number of LEDs to add.
+     * @return Result Done, or Full if they would exceed LedStore::MaxSlots.
+     */
+    Result addLeds(int count);
+
+    /**
+     * @brief Removes every LED.
+     * @return Result Done, or NoLeds.
+     */
+    Result removeAll();
+
+    /**
+     * @brief Removes every LED that is off.
+     * @return Result Done, NoLeds, or NoneOff if every LED is on.
+     */
+    Result removeOff();
+
+    /**
+     * @brief Removes the LEDs in a set of slots.
+     * @details The LEDs are logged as one batch before any of them is removed, so that their display numbers are computed in one pass.
+     * @param targets The slots of the LEDs to remove. Must be live and distinct.
+     */
+    void removeSlots(const QVector<int> &targets);
+
+    /**
+     * @brief Removes one LED.
+     * @param slot The slot of the LED. Must be live.
+     */
+    void remove(int slot);
+
+    /**
+     * @brief Turns every LED on or off.
+     * @details LEDs that are turned on become white, LEDs that are turned off stop blinking, and either way every duration is cancelled. LEDs already in the requested state keep their color.
+     * @param state True to turn the LEDs on, false to turn them off.
+     * @return Result Done, NoLeds, or AllOn or AllOff if there is nothing to change.
+     */
+    Result turnAll(bool state);
+
+    /**
+     * @brief Turns one LED on or off.
+     * @details Does the same to the LED as turnAll() does to every LED.
+     * @param slot The slot of the LED.
+     * @param state True to turn the LED on, false to turn it off.
+     * @return bool True if the LED changed, false if it already was in that state.
+     */
+    bool turn(int slot, bool state);
+
+    /**
+     * @brief Checks that an operation on the LEDs that are on can have an effect.
+     * @details Logs the reason if it cannot. The frontends call it before asking for the value, so that no dialog is shown for nothing.
+     * @param operation The operation about to be carried out.
+     * @return Result Done, NoLeds or NoneOn.
+     */
+    Result checkOnLeds(OnLedsOperation operation) const;
+
+    /**
+     * @brief Changes the color of every LED that is on.
+     * @param color The new color.
+     * @return int The number of LEDs that changed.
+     */
+    int setOnColor(const QColor &color);
+
+    /**
+     * @brief Changes the color of one LED.
+     * @details A transparent color turns the LED off and cancels its duration, any other color turns it on.
+     * @param slot The slot of the LED.
+     * @param color The new color.
+     */
+    void setColor(int slot, const QColor &color);
+
+    /**
+     * @brief Gives every LED of one color another color.
+     * @details The on/off state is not touched, so neither color should be transparent. While the store is paletted this is one write to the palette.
+     * @param from The color to replace.
+     * @param to The new color.
+     * @return int The number of LEDs that changed.
+     */
+    int recolor(QRgb from, QRgb to);
+
+    /**
+     * @brief Sets the blinking speed of every LED that is on.
+     * @param speed The blinking speed in milliseconds, 0 to stop blinking.
+     * @return int The number of LEDs that changed.
+     */
+    int setOnBlinkSpeed(int speed);
+
+    /**
+     * @brief Sets the blinking speed of one LED.
+     * @param slot The slot of the LED.
+     * @param speed The blinking speed in milliseconds, 0 to stop blinking.
+     */
+    void setBlinkSpeed(int slot, int speed);
+
+    /**
+     * @brief Sets how long every LED that is on stays on.
+     * @details A duration of 0 leaves pending durations untouched.
+     * @param seconds The duration in seconds.
+     * @return int The number of LEDs that changed.
+     */
+    int setOnDuration(int seconds);
+
+    /**
+     * @brief Sets how long one LED stays on.
+     * @details A duration of 0 leaves a pending duration untouched.
+     * @param slot The slot of the LED.
+     * @param seconds The duration in seconds.
+     */
+    void setDuration(int slot, int seconds);
+
+    /**
+     * @brief Cancels the duration of one LED.
+     * @param slot The slot of the LED.
+     */
+    void cancelDuration(int slot);
+
+    /**
+     * @brief Starts, replaces or stops the running effect.
+     * @details Stopping the effect removes its layer, so that every LED shows its own color again.
+     * @param effect The effect, or nullptr to stop it.
+     */
+    void setEffect(QSharedPointer<const Effect> effect);
+
+    /**
+     * @brief Gets the running effect.
+     * @return QSharedPointer<const Effect> The effect, or nullptr if none runs.
+     */
+    QSharedPointer<const Effect> effect() const;
+
+    /**
+     * @brief Clears the store's dirty flags.
+     * @details To be called once the changed LEDs were handed to whatever shows them.
+     */
+    void clearDirty();
+
+signals:
+
+    /**
+     * @brief Signal emitted when LEDs changed by themselves.
+     * @details Covers blink ticks, expired durations and effect frames, none of which a frontend asked for at that moment.
+     */
+    void ledsChanged();
+
+private slots:
+
+    /**
+     * @brief Copies the latest frame of the running effect into the effect layer of the output frame.
+     * @details Connected to EffectEngine::frameReady. The store's colors are left alone.
+     */
+    void applyEffectFrame();
+
+private:
+
+    LedStore store; // State of every LED, indexed by slot.
+    OutputFrame output; // Color corrected colors of the LEDs.
+    BlinkScheduler *blinkScheduler; // Single timer driving the blinking of all LEDs.
+    DurationScheduler *durationScheduler; // Single timer switching off LEDs whose duration ran out.
+    EffectEngine *effectEngine; // Renders the running effect on worker threads.
+
+    /**
+     * @brief Turns one LED on or off without touching its on/off flag or the schedulers.
+     * @details Shared by turn() and turnAll(), which write the flags in their own way.
+     * @param slot The slot of the LED. Must not be in the requested state yet.
+     * @param state True to turn the LED on, false to turn it off.
+     */
+    void switchLed(int slot, bool state);
+
+};
+
+#endif // LEDCONTROLLER_H
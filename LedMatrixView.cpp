@@ -0,0 +1,391 @@
+/**
+ * @file LedMatrixView.cpp
+ * @brief Implementation of the LedMatrixView class.
+ * @details This file contains the implementation of the LedMatrixView class, including the grid geometry, the scroll range, the single-pass painting of the LEDs inside the viewport, and the hit testing that drives the left-click toggle and right-click context menu.
+ * @see LedMatrixView.h for the declaration of the LedMatrixView class.
+ * @author Group 3
+ */
+
+#include "include/interfaces/LedMatrixView.h"
+#include "include/utils/Trace.h"
+
+// Including necessary modules.
+#include <QColorDialog>
+#include <QContextMenuEvent>
+#include <QInputDialog>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QPaintEvent>
+#include <QResizeEvent>
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+#include "include/utils/FrameStats.h"
+#endif
+
+namespace {
+
+const int LedSize = 50; // Width and height of one LED in pixels.
+const int Spacing = 6; // Gap between neighbouring LEDs.
+const int Margin = 9; // Gap between the LEDs and the edge of the view.
+const int Pitch = LedSize + Spacing; // Distance between the origins of neighbouring cells.
+
+}
+
+/**
+ * @brief Constructs a LedMatrixView.
+ * @details Stores references to the LED store and the output frame and configures the scroll bars and the viewport. The columns always fit the viewport width, so there is no horizontal scrolling.
+ * @param store The store holding the LEDs to display.
+ * @param output The corrected colors of the LEDs.
+ * @param parent The parent widget.
+ */
+LedMatrixView::LedMatrixView(const LedStore &store, const OutputFrame &output, QWidget *parent) : QAbstractScrollArea(parent), store(store), output(output) {
+
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    verticalScrollBar()->setSingleStep(Pitch);
+    viewport()->setAttribute(Qt::WA_OpaquePaintEvent); // Every exposed pixel is painted, so Qt does not need to clear the background.
+    viewport()->setAttribute(Qt::WA_StaticContents); // Cells stay put when rows are added, so a resize only exposes new areas.
+
+}
+
+/**
+ * @brief Finds the LED under a point.
+ * @details Computes the row and column from the position and checks that the point lies inside the LED rather than in the spacing between cells.
+ * @param pos The position to test.
+ * @return The display position of the LED, or -1 if there is none at that position.
+ */
+int LedMatrixView::indexAt(const QPoint &pos) const {
+
+    int x = pos.x() - Margin;
+    int y = pos.y() + verticalScrollBar()->value() - Margin; // Content coordinates.
+    if (x < 0 || y < 0) {return -1;} // Inside the top or left margin.
+
+    int col = x / Pitch;
+    int row = y / Pitch;
+    if (x % Pitch >= LedSize || y % Pitch >= LedSize) {return -1;} // Between two cells.
+
+    int cols = columnsForWidth(viewport()->width());
+    if (col >= cols) {return -1;} // Beyond the last column.
+
+    int index = row * cols + col;
+    return index < store.size() ? index : -1;
+
+}
+
+/**
+ * @brief Gets the rectangle occupied by an LED.
+ * @details Derives the cell position from the display position and the number of columns that fit into the viewport, then shifts it by the scroll offset.
+ * @param index The display position of the LED.
+ * @return The cell rectangle in viewport coordinates.
+ */
+QRect LedMatrixView::cellRect(int index) const {
+    int cols = columnsForWidth(viewport()->width());
+    int top = Margin + (index / cols) * Pitch - verticalScrollBar()->value();
+    return QRect(Margin + (index % cols) * Pitch, top, LedSize, LedSize);
+}
+
+/**
+ * @brief Gets the number of pixels the last paint covered.
+ * @return The area of the last exposed region.
+ */
+qint64 LedMatrixView::lastFramePixels() const {
+    return framePixels;
+}
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+/**
+ * @brief Attaches statistics that record every paint and layout pass.
+ * @param stats The statistics to record into, or nullptr.
+ */
+void LedMatrixView::setFrameStats(FrameStats *stats) {
+    frameStats = stats;
+}
+#endif
+
+/**
+ * @brief Computes how many rows the LEDs take up at the current viewport width.
+ * @return The number of rows.
+ */
+int LedMatrixView::rowCount() const {
+    int cols = columnsForWidth(viewport()->width());
+    return (store.size() + cols - 1) / cols;
+}
+
+/**
+ * @brief Repaints the LEDs the store marked dirty.
+ * @details Only the cells inside the viewport are checked, so the cost is bounded by the viewport size however many LEDs changed. Dirty cells next to each other in a row are merged into one rectangle, and a run that covers the same columns as a run in the row above extends that rectangle downwards, so a block of changed LEDs becomes a single rectangle. Qt merges the rectangles into the viewport's pending update region.
+ */
+void LedMatrixView::updateDirty() {
+
+    Trace::Span span("LedMatrixView::updateDirty");
+
+    if (store.isAllDirty()) {
+        viewport()->update();
+        return;
+    }
+    if (store.isEmpty()) {return;}
+
+    // Finding the display positions inside the viewport.
+    int offset = verticalScrollBar()->value();
+    int cols = columnsForWidth(viewport()->width());
+    int firstRow = qMax(0, (offset - Margin) / Pitch);
+    int lastRow = qMax(0, (offset + viewport()->height() - Margin) / Pitch);
+    int lastIndex = qMin(store.size() - 1, (lastRow + 1) * cols - 1);
+
+    const QVector<int> &order = store.displayOrder();
+    const BitSet &dirty = store.dirtyBits();
+    dirtyRects.clear();
+    int previousRow = 0; // Index of the first rectangle that ended in the row above.
+
+    for (int row = firstRow; row * cols <= lastIndex; ++row) {
+        const int currentRow = dirtyRects.size();
+        const int rowEnd = qMin(lastIndex, (row + 1) * cols - 1);
+        for (int i = row * cols; i <= rowEnd; ++i) {
+            if (!dirty.test(order.at(i))) {continue;}
+            int end = i;
+            while (end < rowEnd && dirty.test(order.at(end + 1))) {++end;} // Extending the run along the row.
+            const QRect run = cellRect(i).united(cellRect(end));
+            bool extended = false;
+            for (int r = previousRow; r < currentRow && !extended; ++r) {
+                QRect &above = dirtyRects[r];
+                if (above.left() == run.left() && above.right() == run.right() && above.bottom() + Spacing + 1 == run.top()) {
+                    above.setBottom(run.bottom());
+                    extended = true;
+                }
+            }
+            if (!extended) {dirtyRects.append(run);}
+            i = end;
+        }
+        previousRow = currentRow;
+    }
+
+    for (const QRect &rect : std::as_const(dirtyRects)) {viewport()->update(rect);}
+
+}
+
+/**
+ * @brief Updates the view after LEDs were appended.
+ * @details Appending never moves existing cells, so adding LEDs one at a time costs O(1) layout work each.
+ * @param count The number of LEDs appended at the end of the display order.
+ */
+void LedMatrixView::ledsAppended(int count) {
+    if (count <= 0) {return;}
+    syncRows();
+    viewport()->update(cellsRect(store.size() - count, store.size() - 1)); // Clipped to the viewport, so off-screen cells cost nothing.
+}
+
+/**
+ * @brief Updates the view after an LED was removed.
+ * @details The cell at the old end of the grid is included so that it is cleared.
+ * @param index The display position the removed LED had.
+ */
+void LedMatrixView::ledRemoved(int index) {
+    syncRows();
+    viewport()->update(cellsRect(index, store.size()));
+}
+
+/**
+ * @brief Updates the view after arbitrary changes to the set of LEDs.
+ * @details Recomputes the scroll range, since the number of rows may have changed, and repaints the viewport.
+ */
+void LedMatrixView::refreshLayout() {
+    laidOutRows = rowCount();
+    updateScrollRange();
+    viewport()->update();
+}
+
+/**
+ * @brief Recomputes the scroll range if the number of rows changed.
+ * @details Only a change in the number of rows changes the content height, so the scroll bar is left alone otherwise.
+ */
+void LedMatrixView::syncRows() {
+    int rows = rowCount();
+    if (rows == laidOutRows) {return;}
+    laidOutRows = rows;
+    updateScrollRange();
+}
+
+/**
+ * @brief Sets the scroll range from the number of rows and the viewport height.
+ * @details The content height is the number of rows times the row pitch plus the margins, so the range is O(1) to compute no matter how many LEDs there are.
+ */
+void LedMatrixView::updateScrollRange() {
+    Trace::Span span("LedMatrixView::updateScrollRange");
+#ifdef PILLUMINATE_PERF_OVERLAY
+    if (frameStats) {frameStats->addLayout();}
+#endif
+    int contentHeight = 2 * Margin + qMax(0, laidOutRows * Pitch - Spacing);
+    int viewportHeight = viewport()->height();
+    verticalScrollBar()->setPageStep(viewportHeight);
+    verticalScrollBar()->setRange(0, qMax(0, contentHeight - viewportHeight));
+}
+
+/**
+ * @brief Gets the area covered by a range of cells.
+ * @param first The display position of the first cell.
+ * @param last The display position of the last cell.
+ * @return The area in viewport coordinates.
+ */
+QRect LedMatrixView::cellsRect(int first, int last) const {
+    int cols = columnsForWidth(viewport()->width());
+    if (first / cols == last / cols) {return cellRect(first).united(cellRect(last));}
+    int offset = verticalScrollBar()->value();
+    int top = Margin + (first / cols) * Pitch - offset;
+    int bottom = Margin + (last / cols) * Pitch + LedSize - offset;
+    return QRect(0, top, viewport()->width(), bottom - top);
+}
+
+/**
+ * @brief Paints the LEDs.
+ * @details The exposed region is usually a handful of small rectangles around the LEDs that changed, so each rectangle is painted on its own rather than the bounding rectangle of all of them. The rectangles of a region do not overlap, so their areas add up to the number of pixels painted, which is kept as the last frame's pixel count and handed to the performance overlay's statistics while it is shown.
+ * @param event The paint event of the viewport.
+ */
+void LedMatrixView::paintEvent(QPaintEvent *event) {
+
+    Trace::Span span("LedMatrixView::paintEvent");
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+    FrameStats::PaintScope measured(frameStats); // Timing the paint while the performance overlay is shown.
+#endif
+    QPainter painter(viewport());
+
+    framePixels = 0;
+    for (const QRect &exposed : event->region()) {
+        paintCells(painter, exposed);
+        framePixels += qint64(exposed.width()) * exposed.height();
+    }
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+    if (frameStats) {frameStats->addPixels(framePixels);}
+#endif
+
+}
+
+/**
+ * @brief Paints the background and LEDs inside one rectangle.
+ * @details Fills the rectangle with the background color and draws every LED in the rows it covers, mapping each display position to its slot and reading blink phases straight from the store's arrays and colors from the output frame, so that LEDs are drawn color corrected. The rectangle never extends beyond the viewport, so the number of LEDs visited is bounded by the viewport size. An LED in the dim phase of its blink cycle is drawn with a reduced alpha, and an LED that is off is drawn transparent. Each LED is blitted from the sprite cache, so an ellipse is only rasterized the first time a color, phase and pixel ratio combination appears.
+ * @param painter The painter of the viewport.
+ * @param exposed The rectangle to paint.
+ */
+void LedMatrixView::paintCells(QPainter &painter, const QRect &exposed) {
+
+    painter.fillRect(exposed, Qt::gray); // Background of the LED area.
+
+    if (store.isEmpty()) {return;}
+
+    // Restricting the loop to the rows that intersect the exposed region, in content coordinates.
+    int offset = verticalScrollBar()->value();
+    int cols = columnsForWidth(viewport()->width());
+    int firstRow = qMax(0, (exposed.top() + offset - Margin) / Pitch);
+    int lastRow = qMax(0, (exposed.bottom() + offset - Margin) / Pitch);
+    int first = firstRow * cols;
+    int last = qMin(store.size() - 1, (lastRow + 1) * cols - 1);
+
+    const qreal ratio = viewport()->devicePixelRatioF();
+    const QVector<int> &order = store.displayOrder();
+    const BitSet &phases = store.blinkPhaseBits();
+
+    for (int i = first; i <= last; ++i) {
+        QRect cell = cellRect(i);
+        if (!cell.intersects(exposed)) {continue;}
+        const int slot = order.at(i);
+        QRgb rgba = output.rgba(slot);
+        if (!phases.test(slot)) {rgba = qRgba(qRed(rgba), qGreen(rgba), qBlue(rgba), 50);} // Dimmed color for the off phase of a blink.
+        painter.drawPixmap(cell.topLeft(), sprites.sprite(rgba, LedSize, ratio));
+    }
+
+}
+
+/**
+ * @brief Handles mouse press events to toggle an LED on or off.
+ * @details A left mouse button click on an LED changes its state from on to off, or vice versa.
+ * @param event The mouse event of the viewport.
+ */
+void LedMatrixView::mousePressEvent(QMouseEvent *event) {
+
+    int index = indexAt(event->position().toPoint());
+    if (index < 0 || event->button() != Qt::LeftButton) {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+
+    emit toggleRequested(store.handleOf(store.displayOrder().at(index))); // Let the interface turn the LED on or off.
+
+}
+
+/**
+ * @brief Creates a context menu for the LED under the cursor.
+ * @details Generates a right-click context menu with options to change the LED's color, set its blinking speed, specify a duration for it to remain on, or remove the LED entirely. Options are context-sensitive, based on the LED's state.
+ * @param event The context menu event of the viewport.
+ */
+void LedMatrixView::contextMenuEvent(QContextMenuEvent *event) {
+
+    int index = indexAt(event->pos());
+    if (index < 0) {return;} // No LED under the cursor.
+
+    int slot = store.displayOrder().at(index);
+    int id = store.handleOf(slot);
+    QMenu menu(this);
+    QAction *removeAction = menu.addAction("Remove"); // Option to remove the LED.
+
+    if (store.isOn(slot)) { // Only show additional options if the LED is on.
+
+        QAction *colorAction = menu.addAction("Change Color");
+        connect(colorAction, &QAction::triggered, this, [this, slot, id](){
+            QColor selectedColor = QColorDialog::getColor(store.color(slot), this, "Select LED Color");
+            if (selectedColor.isValid()) {emit colorChangeRequested(id, selectedColor);} // Let the interface change the LED's color.
+        });
+
+        QAction *blinkSpeedAction = menu.addAction("Set Blinking Speed");
+        connect(blinkSpeedAction, &QAction::triggered, this, [this, slot, id]() {
+            bool ok;
+            int speed = QInputDialog::getInt(this, "Set Blinking Speed", "Speed (ms):", store.blinkPeriod(slot), 0, 10000, 1, &ok); // Prompt the user to enter a new blinking speed with a dialog.
+            if (ok) {emit blinkSpeedChangeRequested(id, speed);} // If the user pressed OK, update the blinking speed.
+        });
+
+        QAction *setDurationAction = menu.addAction("Set Duration");
+        connect(setDurationAction, &QAction::triggered, this, [this, id]() {
+            bool ok;
+            int duration = QInputDialog::getInt(this, "Set Duration", "Duration (seconds):", 0, 1, 3600, 1, &ok); // Prompt the user to enter a duration after which the LED should turn off.
+            if (ok) {emit durationChangeRequested(id, duration);} // If the user pressed OK, set the duration.
+        });
+
+    }
+
+    QAction *selectedAction = menu.exec(event->globalPos());
+    if (selectedAction == removeAction) {emit removeRequested(id);} // If the remove action is selected, ask the interface to remove the LED.
+
+}
+
+/**
+ * @brief Handles resizing of the viewport.
+ * @details A change in height leaves every cell in place, so only the newly exposed area is painted. A change in the number of columns reflows the whole grid, so the viewport is repainted entirely.
+ * @param event The resize event of the viewport.
+ */
+void LedMatrixView::resizeEvent(QResizeEvent *event) {
+    QAbstractScrollArea::resizeEvent(event);
+    laidOutRows = rowCount();
+    updateScrollRange();
+    if (columnsForWidth(event->size().width()) != columnsForWidth(event->oldSize().width())) {viewport()->update();}
+}
+
+/**
+ * @brief Scrolls the contents of the viewport.
+ * @details The scroll offset is read from the scroll bar wherever it is needed, so there is no state to update here.
+ * @param dx The horizontal scroll distance.
+ * @param dy The vertical scroll distance.
+ */
+void LedMatrixView::scrollContentsBy(int dx, int dy) {
+    viewport()->scroll(dx, dy);
+}
+
+/**
+ * @brief Computes how many columns fit into a width.
+ * @param width The available width.
+ * @return The number of columns, never less than one.
+ */
+int LedMatrixView::columnsForWidth(int width) {
+    return qMax(1, (width - 2 * Margin + Spacing) / Pitch);
+}
@@ -0,0 +1,233 @@
+/**
+ * @file LedMatrixView.h
+ * @brief Defines the LedMatrixView class, which draws every LED on a single canvas.
+ * @details This header file contains the declaration of the LedMatrixView class. Instead of giving each LED its own widget, the view lays the LEDs out as a grid of fixed-size cells and paints them from one paintEvent. The view is its own scroll area and only ever paints the rows inside its viewport, so its cost depends on the viewport size rather than on the number of LEDs. It performs its own hit testing so that clicking an LED toggles it and right-clicking opens the per-LED context menu; the resulting actions are forwarded to UserInterface as signals.
+ * @author Group 3
+ */
+
+#ifndef LEDMATRIXVIEW_H
+#define LEDMATRIXVIEW_H
+
+#include "include/interfaces/SpriteCache.h"
+#include "include/models/LedStore.h"
+#include "include/models/OutputFrame.h"
+
+// Including necessary modules.
+#include <QAbstractScrollArea>
+#include <QColor>
+#include <QRect>
+#include <QVector>
+
+class QPainter;
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+class FrameStats;
+#endif
+
+/**
+ * @class LedMatrixView
+ * @brief Renders the contents of a LedStore as a virtualized, scrollable grid.
+ * @details The view reads LED state straight from the arrays of the store owned by LedController, and uses the store's display order to map cells to slots and the store's handles as LED IDs. Cells are laid out row by row with as many columns as fit into the viewport width, so positions are computed arithmetically rather than by a layout manager. The vertical scroll range is derived from the number of rows times the row pitch, and nothing outside the viewport is materialized: painting, hit testing and repaint requests all translate between content and viewport coordinates by the scroll offset. Scrolling moves the already painted pixels and only paints the newly exposed strip.
+ * @author Group 3
+ */
+class LedMatrixView : public QAbstractScrollArea {
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructor for LedMatrixView.
+     * @details Creates a view over the given store, with a vertical scroll bar shown as needed and no horizontal one. Neither the store nor the output frame is copied; the caller must keep them alive for the lifetime of the view, call ledsAppended(), ledRemoved() or refreshLayout() after changing the set of LEDs, and update the output frame before asking for a repaint.
+     * @param store The store holding the LEDs to display.
+     * @param output The corrected colors of the store's LEDs, which are the colors drawn.
+     * @param parent The parent widget.
+     */
+    LedMatrixView(const LedStore &store, const OutputFrame &output, QWidget *parent = nullptr);
+
+    /**
+     * @brief Finds the LED under a point.
+     * @details Maps a position in viewport coordinates to the display position of the LED whose cell contains it. The slot follows from LedStore::displayOrder().
+     * @param pos The position to test, in viewport coordinates.
+     * @return int The display position of the LED, or -1 if the position is not over an LED.
+     */
+    int indexAt(const QPoint &pos) const;
+
+    /**
+     * @brief Gets the rectangle occupied by an LED.
+     * @details Computes the cell of the LED at the given display position for the current viewport width and scroll offset.
+     * @param index The display position of the LED.
+     * @return QRect The cell rectangle in viewport coordinates.
+     */
+    QRect cellRect(int index) const;
+
+    /**
+     * @brief Gets the number of pixels the last paint covered.
+     * @details Kept whether or not the performance overlay is built, so that the cost of a frame can be read in any build.
+     * @return qint64 The area of the region exposed in the last paint, in device-independent pixels.
+     */
+    qint64 lastFramePixels() const;
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+    /**
+     * @brief Attaches statistics that record every paint and layout pass.
+     * @param stats The statistics to record into, or nullptr to stop recording.
+     */
+    void setFrameStats(FrameStats *stats);
+#endif
+
+public slots:
+
+    /**
+     * @brief Repaints the LEDs the store marked dirty.
+     * @details Schedules a repaint of the visible cells whose LEDs changed color or blink phase since the store's dirty flags were last cleared, merged into as few rectangles as possible, so the repainted area follows the number of changed LEDs rather than the size of the viewport. Falls back to repainting the viewport if the store marked everything dirty. The caller clears the dirty flags afterwards.
+     */
+    void updateDirty();
+
+    /**
+     * @brief Updates the view after LEDs were appended.
+     * @details Only the new cells are repainted, and the scroll range is only recomputed if the number of rows changed.
+     * @param count The number of LEDs appended at the end of the display order.
+     */
+    void ledsAppended(int count);
+
+    /**
+     * @brief Updates the view after an LED was removed.
+     * @details The LEDs after the removed one each move back by one cell, so only the cells from the removed position to the previous last cell are repainted. The scroll range is only recomputed if the number of rows changed.
+     * @param index The display position the removed LED had.
+     */
+    void ledRemoved(int index);
+
+    /**
+     * @brief Updates the view after arbitrary changes to the set of LEDs.
+     * @details Recomputes the scroll range and repaints the whole viewport.
+     */
+    void refreshLayout();
+
+signals:
+
+    /**
+     * @brief Signal emitted when the user asks to remove an LED.
+     * @param id The ID of the LED to remove.
+     */
+    void removeRequested(int id);
+
+    /**
+     * @brief Signal emitted when the user clicks an LED to switch it on or off.
+     * @param id The ID of the LED to toggle.
+     */
+    void toggleRequested(int id);
+
+    /**
+     * @brief Signal emitted when the user picks a new blinking speed for an LED.
+     * @param id The ID of the LED.
+     * @param speed The blinking speed in milliseconds, 0 to stop blinking.
+     */
+    void blinkSpeedChangeRequested(int id, int speed);
+
+    /**
+     * @brief Signal emitted when the user sets how long an LED stays on.
+     * @param id The ID of the LED.
+     * @param seconds The duration in seconds.
+     */
+    void durationChangeRequested(int id, int seconds);
+
+    /**
+     * @brief Signal emitted when the user picks a new color for an LED.
+     * @param id The ID of the LED.
+     * @param color The new color for the LED.
+     */
+    void colorChangeRequested(int id, const QColor &color);
+
+protected:
+
+    /**
+     * @brief Paints the LEDs.
+     * @details Paints each rectangle of the exposed region separately, blitting the sprite of every LED whose cell intersects it, chosen by its current color and blink phase.
+     * @param event The paint event of the viewport.
+     */
+    void paintEvent(QPaintEvent *event) override;
+
+    /**
+     * @brief Handles mouse press events.
+     * @details Toggles the LED under the cursor on or off with a left click.
+     * @param event The mouse event.
+     */
+    void mousePressEvent(QMouseEvent *event) override;
+
+    /**
+     * @brief Creates a context menu.
+     * @details Opens a context menu for the LED under the cursor, offering options like changing color, configuring blink settings, setting a duration or removing it.
+     * @param event The context menu event.
+     */
+    void contextMenuEvent(QContextMenuEvent *event) override;
+
+    /**
+     * @brief Handles resizing of the viewport.
+     * @details Recomputes the scroll range. The viewport keeps its contents on resize, so only newly exposed areas are repainted, unless the number of columns changed and every cell moves.
+     * @param event The resize event of the viewport.
+     */
+    void resizeEvent(QResizeEvent *event) override;
+
+    /**
+     * @brief Scrolls the contents of the viewport.
+     * @details Moves the pixels already painted, so only the strip scrolled into view needs painting.
+     * @param dx The horizontal scroll distance, always 0.
+     * @param dy The vertical scroll distance.
+     */
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+
+    const LedStore &store; // State of the LEDs being displayed, owned by LedController.
+    const OutputFrame &output; // Colors the LEDs output, owned by LedController.
+    int laidOutRows = 0; // Number of rows at the last scroll range update.
+    SpriteCache sprites; // Pre-rendered LEDs, blitted instead of drawing ellipses.
+    QVector<QRect> dirtyRects; // Scratch buffer of updateDirty(), kept so that blink ticks do not allocate.
+    qint64 framePixels = 0; // Pixels covered by the last paint.
+#ifdef PILLUMINATE_PERF_OVERLAY
+    FrameStats *frameStats = nullptr; // Statistics of the performance overlay, while it is shown.
+#endif
+
+    /**
+     * @brief Computes how many rows the LEDs take up at the current viewport width.
+     * @return int The number of rows.
+     */
+    int rowCount() const;
+
+    /**
+     * @brief Recomputes the scroll range if the number of rows changed.
+     */
+    void syncRows();
+
+    /**
+     * @brief Sets the scroll range from the number of rows and the viewport height.
+     */
+    void updateScrollRange();
+
+    /**
+     * @brief Paints the background and LEDs inside one rectangle.
+     * @param painter The painter of the viewport.
+     * @param exposed The rectangle to paint, in viewport coordinates.
+     */
+    void paintCells(QPainter &painter, const QRect &exposed);
+
+    /**
+     * @brief Gets the area covered by a range of cells.
+     * @details Within a single row this is the bounding rectangle of the cells; across several rows it spans the full width of those rows.
+     * @param first The display position of the first cell.
+     * @param last The display position of the last cell.
+     * @return QRect The area in viewport coordinates.
+     */
+    QRect cellsRect(int first, int last) const;
+
+    /**
+     * @brief Computes how many columns fit into a width.
+     * @param width The available width.
+     * @return int The number of columns, at least one.
+     */
+    static int columnsForWidth(int width);
+
+};
+
+#endif // LEDMATRIXVIEW_H
@@ -0,0 +1,711 @@
+/**
+ * @file LedStore.cpp
+ * @brief Implementation of the LedStore class.
+ * @details This file contains the implementation of the LedStore class, which keeps LED state in parallel arrays indexed by slot. Slots are recycled through a free list, and every change to the set of LEDs (append, remove, clear) is applied to all arrays and to the off-deadline timing wheel together so that they always have the same length.
+ * @see LedStore.h for the declaration of the LedStore class.
+ * @author Group 3
+ */
+
+#include "include/models/LedStore.h"
+
+// Including necessary modules.
+#include <QtAlgorithms>
+
+/**
+ * @brief Constructs an empty LedStore.
+ * @details Starts the monotonic clock used for off-deadlines and sets up the palette with its transparent entry.
+ */
+LedStore::LedStore() {
+    clock.start();
+    resetPalette();
+}
+
+namespace {
+
+const int GenerationLimit = 1 << (31 - LedStore::SlotBits); // Generations wrap around before reaching this, keeping handles positive.
+
+}
+
+const QRgb LedStore::Transparent; // Defined here since both colors are passed by reference.
+const QRgb LedStore::White;
+
+/**
+ * @brief Gets the number of LEDs in the store.
+ * @return The number of live slots.
+ */
+int LedStore::size() const {
+    return liveCount;
+}
+
+/**
+ * @brief Checks if the store is empty.
+ * @return True if there are no LEDs, false otherwise.
+ */
+bool LedStore::isEmpty() const {
+    return liveCount == 0;
+}
+
+/**
+ * @brief Gets the number of LEDs that are on.
+ * @return The number of LEDs that are on.
+ */
+int LedStore::onCount() const {
+    return onTotal;
+}
+
+/**
+ * @brief Gets the number of LEDs that are blinking.
+ * @return The number of LEDs that are on and have a blink period.
+ */
+int LedStore::blinkingCount() const {
+    return blinkingTotal;
+}
+
+/**
+ * @brief Gets the number of LEDs with a pending off-deadline.
+ * @return The number of timed LEDs.
+ */
+int LedStore::timedCount() const {
+    return timedTotal;
+}
+
+/**
+ * @brief Gets the length of the state arrays.
+ * @return The number of slots, live or free.
+ */
+int LedStore::slotCount() const {
+    return live.size();
+}
+
+/**
+ * @brief Reserves memory for a number of LEDs.
+ * @param count The number of LEDs to reserve space for.
+ */
+void LedStore::reserve(int count) {
+    live.reserve(count);
+    generations.reserve(count);
+    if (paletted) {colorIndices.reserve(count);}
+    else {colors.reserve(count);}
+    on.reserve(count);
+    blinkPeriods.reserve(count);
+    periodic.reserve(count);
+    blinkPhases.reserve(count);
+    dirty.reserve(count);
+    offDeadlines.reserve(count);
+    offWheel.reserve(count);
+    order.reserve(count);
+    orderIndex.reserve(count);
+}
+
+/**
+ * @brief Adds an LED at the end of the display order.
+ * @details A freed slot already holds the default state, so reusing it only marks it live and dirty, the latter so that whatever was derived from the removed LED, such as its corrected color, is refreshed before the new one is drawn. Otherwise the default state is appended to every array: transparent, off, not blinking, lit phase and no off-deadline. Generations survive clear(), so a slot that existed before keeps counting from its old generation. The check for a full store is made in release builds as well, since a slot beyond MaxSlots would not fit into a handle and would alias another LED.
+ * @return The slot of the new LED, or -1 if the store is full.
+ */
+int LedStore::append() {
+
+    int slot;
+    if (freeSlots.isEmpty() && live.size() >= MaxSlots) {return -1;}
+    if (!freeSlots.isEmpty()) {
+        slot = freeSlots.takeLast();
+        live.set(slot, true);
+        dirty.set(slot, true);
+    } else {
+        slot = live.size();
+        live.append(true);
+        if (slot == generations.size()) {generations.append(1);}
+        if (paletted) {
+            colorIndices.append(0); // The transparent entry.
+            ++paletteUses[0];
+        } else {
+            colors.append(Transparent);
+        }
+        on.append(false);
+        blinkPeriods.append(0);
+        periodic.append(false);
+        blinkPhases.append(true);
+        dirty.append(false);
+        offDeadlines.append(-1);
+        offWheel.appendKey();
+        orderIndex.append(-1);
+    }
+
+    orderIndex[slot] = order.size();
+    order.append(slot);
+    ++liveCount;
+    return slot;
+
+}
+
+/**
+ * @brief Removes the LED in a slot.
+ * @details Resets the slot to the default state so that bulk loops can treat it like an LED that is off, and leaves its entry in the append log to be dropped by the next compaction. The log is compacted here once stale entries outnumber live ones, which keeps removal O(1) amortized.
+ * @param slot The slot to remove.
+ */
+void LedStore::remove(int slot) {
+    live.set(slot, false);
+    generations[slot] = generations.at(slot) + 1 < GenerationLimit ? generations.at(slot) + 1 : 1;
+    setRgba(slot, Transparent);
+    setOn(slot, false);
+    setBlinkPeriod(slot, 0);
+    setBlinkPhase(slot, true);
+    setOffDeadline(slot, -1);
+    freeSlots.append(slot);
+    ++staleEntries;
+    --liveCount;
+    if (staleEntries > liveCount + 64) {compactOrder();} // Bounding the append log when nobody asks for the display order.
+}
+
+/**
+ * @brief Removes every LED from the store.
+ * @details Every array except the generations is emptied. The generations of all slots are bumped instead, so that handles issued before the call stay detectably stale once the slots are used again.
+ */
+void LedStore::clear() {
+    for (int i = live.nextSet(0); i >= 0; i = live.nextSet(i + 1)) {
+        generations[i] = generations.at(i) + 1 < GenerationLimit ? generations.at(i) + 1 : 1;
+    }
+    liveCount = 0;
+    onTotal = 0;
+    blinkingTotal = 0;
+    timedTotal = 0;
+    live.clear();
+    freeSlots.clear();
+    resetPalette();
+    on.clear();
+    blinkPeriods.clear();
+    periodic.clear();
+    blinkPhases.clear();
+    dirty.clear();
+    allDirty = false;
+    offDeadlines.clear();
+    offWheel.clear();
+    order.clear();
+    orderIndex.clear();
+    staleEntries = 0;
+}
+
+/**
+ * @brief Finds the slot of an LED by its handle.
+ * @param handle The handle of the LED.
+ * @return The slot of the LED, or -1 if the handle is stale or invalid.
+ */
+int LedStore::slotOf(int handle) const {
+    if (handle <= 0) {return -1;}
+    const int slot = handle & (MaxSlots - 1);
+    if (slot >= live.size() || !live.test(slot) || generations.at(slot) != (handle >> SlotBits)) {return -1;}
+    return slot;
+}
+
+/**
+ * @brief Gets the handle of the LED in a slot.
+ * @param slot The slot of the LED.
+ * @return The handle of the LED.
+ */
+int LedStore::handleOf(int slot) const {
+    return (generations.at(slot) << SlotBits) | slot;
+}
+
+/**
+ * @brief Checks if a slot holds an LED.
+ * @param slot The slot to check.
+ * @return True if the slot is live, false if it is free.
+ */
+bool LedStore::isLive(int slot) const {
+    return slot >= 0 && slot < live.size() && live.test(slot);
+}
+
+/**
+ * @brief Gets the live slots in display order.
+ * @return The slots of all LEDs, in the order in which they were added.
+ */
+const QVector<int> &LedStore::displayOrder() const {
+    if (staleEntries > 0) {compactOrder();}
+    return order;
+}
+
+/**
+ * @brief Gets the position of an LED in the display order.
+ * @param slot The slot of the LED.
+ * @return The zero-based display position.
+ */
+int LedStore::displayIndex(int slot) const {
+    if (staleEntries > 0) {compactOrder();}
+    return orderIndex.at(slot);
+}
+
+/**
+ * @brief Drops the entries of removed LEDs from the append log.
+ * @details Entries are moved down in place, so the pass is O(n) but runs at most once per batch of removals.
+ */
+void LedStore::compactOrder() const {
+    int kept = 0;
+    for (int i = 0; i < order.size(); ++i) {
+        const int slot = order.at(i);
+        if (!live.test(slot) || orderIndex.at(slot) != i) {continue;} // Entry of a removed LED, or an older entry of a reused slot.
+        order[kept] = slot;
+        orderIndex[slot] = kept++;
+    }
+    order.resize(kept);
+    staleEntries = 0;
+}
+
+/**
+ * @brief Gets the color of an LED as a QColor.
+ * @param slot The slot of the LED.
+ * @return The color of the LED.
+ */
+QColor LedStore::color(int slot) const {
+    return QColor::fromRgba(rgba(slot));
+}
+
+/**
+ * @brief Sets the color of an LED from a QColor.
+ * @param slot The slot of the LED.
+ * @param color The new color.
+ */
+void LedStore::setColor(int slot, const QColor &color) {
+    setRgba(slot, color.rgba());
+}
+
+/**
+ * @brief Gets the packed color of an LED.
+ * @param slot The slot of the LED.
+ * @return The color of the LED as ARGB32.
+ */
+QRgb LedStore::rgba(int slot) const {
+    return paletted ? palette.at(colorIndices.at(slot)) : colors.at(slot);
+}
+
+/**
+ * @brief Sets the packed color of an LED.
+ * @details An LED that is the only user of its palette entry gets the entry recolored in place, so that changing the color of one LED back and forth does not use up entries. When the palette is full, the store is expanded to one QRgb per LED.
+ * @param slot The slot of the LED.
+ * @param rgba The new color as ARGB32.
+ */
+void LedStore::setRgba(int slot, QRgb rgba) {
+
+    if (rgba == this->rgba(slot)) {return;}
+    dirty.set(slot, true);
+
+    if (!paletted) {
+        colors[slot] = rgba;
+        return;
+    }
+
+    const int old = colorIndices.at(slot);
+
+    int entry = findEntry(rgba);
+    if (entry < 0 && old != 0 && paletteUses.at(old) == 1) {
+        paletteLookup.remove(palette.at(old));
+        palette[old] = rgba;
+        paletteLookup.insert(rgba, old);
+        if (lastEntry == old) {lastRgba = rgba;}
+        return;
+    }
+    if (entry < 0) {entry = newEntry(rgba);}
+    if (entry < 0) { // The palette is full.
+        expandPalette();
+        colors[slot] = rgba;
+        return;
+    }
+
+    ++paletteUses[entry];
+    colorIndices[slot] = quint8(entry);
+    releaseEntry(old);
+
+}
+
+/**
+ * @brief Gives every LED of one color another color.
+ * @param from The color to replace.
+ * @param to The new color.
+ * @return The number of LEDs that changed color.
+ */
+int LedStore::replaceColor(QRgb from, QRgb to) {
+
+    Q_ASSERT(from != Transparent && to != Transparent);
+    if (from == to) {return 0;}
+
+    if (!paletted) {
+        int changed = 0;
+        for (int i = live.nextSet(0); i >= 0; i = live.nextSet(i + 1)) {
+            if (colors.at(i) == from) {
+                colors[i] = to;
+                dirty.set(i, true);
+                ++changed;
+            }
+        }
+        return changed;
+    }
+
+    const int entry = findEntry(from);
+    if (entry < 0) {return 0;}
+    const int changed = paletteUses.at(entry);
+    const int existing = findEntry(to);
+
+    if (existing < 0) { // The single write.
+        paletteLookup.remove(from);
+        palette[entry] = to;
+        paletteLookup.insert(to, entry);
+    } else { // Merging into the entry that already has the new color.
+        quint8 *indices = colorIndices.data();
+        const int count = colorIndices.size();
+        for (int i = 0; i < count; ++i) {if (indices[i] == entry) {indices[i] = quint8(existing);}}
+        paletteUses[existing] += changed;
+        paletteUses[entry] = 1;
+        releaseEntry(entry);
+    }
+
+    lastRgba = Transparent;
+    lastEntry = 0;
+    allDirty |= changed > 0;
+    return changed;
+
+}
+
+/**
+ * @brief Gets the number of colors in the palette.
+ * @return The number of palette entries in use, or 0 if the store is not paletted.
+ */
+int LedStore::paletteSize() const {
+    return paletted ? palette.size() - freeEntries.size() : 0;
+}
+
+/**
+ * @brief Empties the palette except for the transparent entry and makes the store paletted again.
+ */
+void LedStore::resetPalette() {
+    paletted = true;
+    colors.clear();
+    colorIndices.clear();
+    palette = QVector<QRgb>(1, Transparent);
+    paletteUses = QVector<int>(1, 0);
+    paletteLookup.clear();
+    paletteLookup.insert(Transparent, 0);
+    freeEntries.clear();
+    lastRgba = Transparent;
+    lastEntry = 0;
+}
+
+/**
+ * @brief Finds the palette entry of a color.
+ * @param rgba The color.
+ * @return The entry, or -1 if the color is not in the palette.
+ */
+int LedStore::findEntry(QRgb rgba) {
+    if (rgba == lastRgba) {return lastEntry;}
+    const int entry = paletteLookup.value(rgba, -1);
+    if (entry >= 0) {
+        lastRgba = rgba;
+        lastEntry = entry;
+    }
+    return entry;
+}
+
+/**
+ * @brief Adds a color to the palette.
+ * @param rgba The color.
+ * @return The new entry, or -1 if the palette is full.
+ */
+int LedStore::newEntry(QRgb rgba) {
+    int entry;
+    if (!freeEntries.isEmpty()) {
+        entry = freeEntries.takeLast();
+    } else if (palette.size() < PaletteLimit) {
+        entry = palette.size();
+        palette.append(rgba);
+        paletteUses.append(0);
+    } else {
+        return -1;
+    }
+    palette[entry] = rgba;
+    paletteLookup.insert(rgba, entry);
+    return entry;
+}
+
+/**
+ * @brief Drops one use of a palette entry, freeing the entry when it has none left.
+ * @param entry The palette entry.
+ */
+void LedStore::releaseEntry(int entry) {
+    if (--paletteUses[entry] > 0 || entry == 0) {return;}
+    paletteLookup.remove(palette.at(entry));
+    freeEntries.append(entry);
+    if (lastEntry == entry) {
+        lastRgba = Transparent;
+        lastEntry = 0;
+    }
+}
+
+/**
+ * @brief Switches from palette indices to one QRgb per LED.
+ * @details One pass over the indices; the palette is released afterwards.
+ */
+void LedStore::expandPalette() {
+    colors.resize(colorIndices.size());
+    for (int i = 0; i < colorIndices.size(); ++i) {colors[i] = palette.at(colorIndices.at(i));}
+    colorIndices.clear();
+    colorIndices.squeeze();
+    palette.clear();
+    paletteUses.clear();
+    paletteLookup.clear();
+    freeEntries.clear();
+    paletted = false;
+}
+
+/**
+ * @brief Checks if an LED is on.
+ * @param slot The slot of the LED.
+ * @return True if the LED is on, false otherwise.
+ */
+bool LedStore::isOn(int slot) const {
+    return on.test(slot);
+}
+
+/**
+ * @brief Sets the on/off state of an LED.
+ * @details Only an actual change moves the counts, so setting the current state again is harmless.
+ * @param slot The slot of the LED.
+ * @param state True for on, false for off.
+ */
+void LedStore::setOn(int slot, bool state) {
+    if (on.test(slot) == state) {return;}
+    on.set(slot, state);
+    const int delta = state ? 1 : -1;
+    onTotal += delta;
+    if (periodic.test(slot)) {blinkingTotal += delta;}
+}
+
+/**
+ * @brief Turns a range of slots on or off at once.
+ * @details The range is clipped to the existing slots first, so no word past the end of the sets is touched. The first and last words are masked to the range. For each word, the counts move by the difference in population count before and after, and the blinking count only looks at the bits that are also periodic, so the cost stays proportional to the range.
+ * @param first The first slot of the range.
+ * @param count The number of slots in the range.
+ * @param state True for on, false for off.
+ */
+void LedStore::setOnRange(int first, int count, bool state) {
+
+    const int begin = qMax(0, first);
+    const int end = int(qMin<qint64>(slotCount(), qint64(first) + count));
+    if (begin >= end) {return;}
+
+    const int last = end - 1;
+    quint64 *onWords = on.wordData();
+    const quint64 *liveWords = live.wordData();
+    const quint64 *periodicWords = periodic.wordData();
+
+    for (int w = begin >> 6; w <= last >> 6; ++w) {
+        quint64 mask = ~quint64(0);
+        if (w == begin >> 6) {mask &= ~quint64(0) << (begin & 63);}
+        if (w == last >> 6) {mask &= ~quint64(0) >> (63 - (last & 63));}
+        const quint64 before = onWords[w];
+        const quint64 after = state ? before | (liveWords[w] & mask) : before & ~mask; // Free slots stay off.
+        onTotal += int(qPopulationCount(after)) - int(qPopulationCount(before));
+        blinkingTotal += int(qPopulationCount(after & periodicWords[w])) - int(qPopulationCount(before & periodicWords[w]));
+        onWords[w] = after;
+    }
+
+}
+
+/**
+ * @brief Gets the blink period of an LED.
+ * @param slot The slot of the LED.
+ * @return The blink period in milliseconds, or 0 if the LED does not blink.
+ */
+int LedStore::blinkPeriod(int slot) const {
+    return blinkPeriods.at(slot);
+}
+
+/**
+ * @brief Sets the blink period of an LED.
+ * @param slot The slot of the LED.
+ * @param period The blink period in milliseconds, or 0 to stop blinking.
+ */
+void LedStore::setBlinkPeriod(int slot, int period) {
+    if (on.test(slot)) {blinkingTotal += int(period > 0) - int(periodic.test(slot));}
+    blinkPeriods[slot] = period;
+    periodic.set(slot, period > 0);
+}
+
+/**
+ * @brief Checks which half of its blink cycle an LED is in.
+ * @param slot The slot of the LED.
+ * @return True for the lit half, false for the dimmed half.
+ */
+bool LedStore::blinkPhase(int slot) const {
+    return blinkPhases.test(slot);
+}
+
+/**
+ * @brief Sets the blink phase of an LED.
+ * @param slot The slot of the LED.
+ * @param lit True for the lit half, false for the dimmed half.
+ */
+void LedStore::setBlinkPhase(int slot, bool lit) {
+    if (blinkPhases.test(slot) == lit) {return;}
+    blinkPhases.set(slot, lit);
+    dirty.set(slot, true);
+}
+
+/**
+ * @brief Sets the blink phases of 64 slots at once.
+ * @details The slots that changed are the bits in which the old and new words differ.
+ * @param word The index of the word.
+ * @param lit The new phases.
+ * @return True if at least one phase changed.
+ */
+bool LedStore::setBlinkPhaseWord(int word, quint64 lit) {
+    quint64 &phases = blinkPhases.wordData()[word];
+    const quint64 changed = phases ^ lit;
+    phases = lit;
+    dirty.wordData()[word] |= changed;
+    return changed != 0;
+}
+
+/**
+ * @brief Gives read access to the dirty flags.
+ * @return The dirty flags.
+ */
+const BitSet &LedStore::dirtyBits() const {
+    return dirty;
+}
+
+/**
+ * @brief Checks if a change affected too many LEDs to track them one by one.
+ * @return True if every LED has to be treated as dirty.
+ */
+bool LedStore::isAllDirty() const {
+    return allDirty;
+}
+
+/**
+ * @brief Marks an LED dirty without changing it.
+ * @param slot The slot of the LED.
+ */
+void LedStore::markDirty(int slot) {
+    dirty.set(slot, true);
+}
+
+/**
+ * @brief Marks every LED dirty without changing any of them.
+ */
+void LedStore::markAllDirty() {
+    allDirty = true;
+}
+
+/**
+ * @brief Clears the dirty flags.
+ */
+void LedStore::clearDirty() {
+    dirty.reset(dirty.size());
+    allDirty = false;
+}
+
+/**
+ * @brief Gets the time at which an LED turns itself off.
+ * @param slot The slot of the LED.
+ * @return The deadline in milliseconds on the store's clock, or -1 if no duration is set.
+ */
+qint64 LedStore::offDeadline(int slot) const {
+    return offDeadlines.at(slot);
+}
+
+/**
+ * @brief Sets the time at which an LED turns itself off.
+ * @details Writes the deadline and arms or cancels the matching entry in the timing wheel.
+ * @param slot The slot of the LED.
+ * @param deadline The deadline in milliseconds on the store's clock, or -1 to cancel it.
+ */
+void LedStore::setOffDeadline(int slot, qint64 deadline) {
+    timedTotal += int(deadline >= 0) - int(offDeadlines.at(slot) >= 0);
+    offDeadlines[slot] = deadline;
+    if (deadline < 0) {offWheel.cancel(slot);}
+    else {offWheel.arm(slot, deadline);}
+}
+
+/**
+ * @brief Cancels the off-deadline of every LED.
+ */
+void LedStore::cancelAllOffDeadlines() {
+    offDeadlines.fill(-1);
+    offWheel.cancelAll();
+    timedTotal = 0;
+}
+
+/**
+ * @brief Gets the time at which pending off-deadlines next need processing.
+ * @return The time in milliseconds on the store's clock, or -1 if nothing is pending.
+ */
+qint64 LedStore::nextOffDeadline() const {
+    return offWheel.nextEventTime();
+}
+
+/**
+ * @brief Collects every LED whose off-deadline has passed.
+ * @details The timing wheel ticks in milliseconds on the store's clock, so it can be advanced to now() directly.
+ * @param expired Vector receiving the slots of the expired LEDs.
+ * @return The number of LEDs that expired.
+ */
+int LedStore::expireOffDeadlines(QVector<int> &expired) {
+    const int first = expired.size();
+    const int count = offWheel.advance(now(), expired);
+    for (int i = first; i < expired.size(); ++i) {offDeadlines[expired.at(i)] = -1;}
+    timedTotal -= count;
+    return count;
+}
+
+/**
+ * @brief Gets the current time on the store's monotonic clock.
+ * @return Milliseconds since the store was created.
+ */
+qint64 LedStore::now() const {
+    return clock.elapsed();
+}
+
+/**
+ * @brief Gives read access to the liveness flags.
+ * @return The liveness flags.
+ */
+const BitSet &LedStore::liveBits() const {
+    return live;
+}
+
+/**
+ * @brief Gives read access to the on/off flags.
+ * @return The on/off flags.
+ */
+const BitSet &LedStore::onBits() const {
+    return on;
+}
+
+/**
+ * @brief Gives read access to the flags of LEDs with a blink period.
+ * @return The periodic flags.
+ */
+const BitSet &LedStore::periodicBits() const {
+    return periodic;
+}
+
+/**
+ * @brief Gives read access to the blink period array.
+ * @return Pointer to the first blink period.
+ */
+const int *LedStore::blinkPeriodData() const {
+    return blinkPeriods.constData();
+}
+
+/**
+ * @brief Gives read access to the blink phase flags.
+ * @return The blink phase flags.
+ */
+const BitSet &LedStore::blinkPhaseBits() const {
+    return blinkPhases;
+}
+
+/**
+ * @brief Gives read access to the off-deadline array.
+ * @return Pointer to the first off-deadline.
+ */
+const qint64 *LedStore::offDeadlineData() const {
+    return offDeadlines.constData();
+}
@@ -0,0 +1,433 @@
+/**
+ * @file LedStore.h
+ * @brief Defines the LedStore class, which holds the state of every LED in contiguous arrays.
+ * @details This header file contains the declaration of the LedStore class. LED state is kept as a structure of arrays indexed by slot: one array each for color, on/off state, blink period, blink phase and off-deadline, with the flags packed into bit sets and the colors packed into 32-bit ARGB values or palette indices. Views and bulk operations read and write these arrays directly instead of going through one object per LED. Pending off-deadlines are additionally indexed by a TimingWheel so that the nearest one can be found without scanning. LEDs are referred to from outside by generational handles, which stay valid while the LED exists and are detectably stale once it has been removed.
+ * @author Group 3
+ */
+
+#ifndef LEDSTORE_H
+#define LEDSTORE_H
+
+#include "include/models/BitSet.h"
+#include "include/models/TimingWheel.h"
+
+// Including necessary modules.
+#include <QColor>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
+
+/**
+ * @class LedStore
+ * @brief Structure-of-arrays storage for LED state.
+ * @details Each LED occupies one slot for its whole lifetime. Removing an LED only frees its slot, which is reused by a later append, so removal is O(1) and nothing else moves. A freed slot holds the default state (off, transparent, not blinking, no off-deadline) and is marked as not live, so bulk loops may run over all slotCount() slots. A handle packs the slot with the slot's generation, which is bumped on every removal; a handle whose generation no longer matches is stale. Display order is the order in which the LEDs were added and is derived lazily from the append log when it is first needed after a removal. Per-slot accessors are provided for single-LED operations, and the data accessors expose the raw arrays so that bulk operations can run as tight loops over contiguous memory. The store also owns the monotonic clock that off-deadlines are measured against, and the timing wheel that indexes them. The off-deadline array is therefore only writable through setOffDeadline() and cancelAllOffDeadlines(), which keep the two in step. Likewise, the on/off and blink period arrays are only writable through setOn(), setOnRange() and setBlinkPeriod(), so that the store can keep running counts of the LEDs that are on, blinking or timed and answer those questions in O(1). The liveness, on/off and blink phase flags, and whether an LED has a blink period, are kept in bit sets; an LED is blinking where the on and periodic sets intersect, so that question is answered 64 LEDs at a time. Every change to the color or blink phase of an LED sets its bit in a dirty set, which the view turns into the rectangles it repaints and the owner clears once per frame; a change that affects many LEDs at once, such as a palette recolor, marks everything dirty instead. Colors are kept as packed QRgb values and only become QColor at the Qt API boundary. While at most PaletteLimit distinct colors are in use, each LED stores a one-byte index into a palette instead, and all LEDs of one color can be recolored with a single write to the palette; the store switches to one QRgb per LED for good, until clear(), once more colors are needed.
+ * @author Group 3
+ */
+class LedStore {
+
+public:
+
+    static const int SlotBits = 20; // Number of handle bits holding the slot.
+    static const int MaxSlots = 1 << SlotBits; // Largest number of slots the store can hold.
+    static const int PaletteLimit = 256; // Largest number of colors the palette can hold, since an index is one byte.
+    static const QRgb Transparent = 0x00000000; // Color of an LED that is off, and of free slots.
+    static const QRgb White = 0xffffffff; // Color of an LED that was just turned on.
+
+    /**
+     * @brief Constructor for LedStore.
+     * @details Creates an empty, paletted store and starts its monotonic clock.
+     */
+    LedStore();
+
+    /**
+     * @brief Gets the number of LEDs in the store.
+     * @return int The number of live slots.
+     */
+    int size() const;
+
+    /**
+     * @brief Checks if the store is empty.
+     * @return bool True if there are no LEDs, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Gets the number of LEDs that are on.
+     * @return int The number of LEDs that are on.
+     */
+    int onCount() const;
+
+    /**
+     * @brief Gets the number of LEDs that are blinking.
+     * @details An LED counts as blinking if it is on and has a blink period, which are the LEDs the blink scheduler animates.
+     * @return int The number of blinking LEDs.
+     */
+    int blinkingCount() const;
+
+    /**
+     * @brief Gets the number of LEDs with a pending off-deadline.
+     * @return int The number of LEDs that are due to turn themselves off.
+     */
+    int timedCount() const;
+
+    /**
+     * @brief Gets the length of the state arrays.
+     * @details This includes freed slots, so it is at least size().
+     * @return int The number of slots, live or free.
+     */
+    int slotCount() const;
+
+    /**
+     * @brief Reserves memory for a number of LEDs.
+     * @details Grows every array to the given capacity at once so that subsequent appends do not reallocate.
+     * @param count The number of LEDs to reserve space for.
+     */
+    void reserve(int count);
+
+    /**
+     * @brief Adds an LED at the end of the display order.
+     * @details Takes the most recently freed slot if there is one, marking it dirty, and grows the arrays otherwise. The new LED is off, transparent, not blinking and has no off-deadline.
+     * @return int The slot of the new LED, or -1 if the store already holds MaxSlots LEDs, in which case nothing changes.
+     */
+    int append();
+
+    /**
+     * @brief Removes the LED in a slot.
+     * @details Resets the slot to the default state, cancels its off-deadline, bumps its generation and puts it on the free list. This is O(1); the display order is compacted lazily.
+     * @param slot The slot to remove. Must be live.
+     */
+    void remove(int slot);
+
+    /**
+     * @brief Removes every LED from the store.
+     * @details Generations are kept and bumped, so every handle issued before the call becomes stale.
+     */
+    void clear();
+
+    /**
+     * @brief Finds the slot of an LED by its handle.
+     * @details Splits the handle into slot and generation and checks the generation, so the lookup is O(1).
+     * @param handle The handle of the LED.
+     * @return int The slot of the LED, or -1 if the handle is stale or invalid.
+     */
+    int slotOf(int handle) const;
+
+    /**
+     * @brief Gets the handle of the LED in a slot.
+     * @param slot The slot of the LED. Must be live.
+     * @return int The handle of the LED, always positive.
+     */
+    int handleOf(int slot) const;
+
+    /**
+     * @brief Checks if a slot holds an LED.
+     * @param slot The slot to check.
+     * @return bool True if the slot is live, false if it is free.
+     */
+    bool isLive(int slot) const;
+
+    /**
+     * @brief Gets the live slots in display order.
+     * @details Compacts the append log first if LEDs were removed since the last call.
+     * @return const QVector<int>& The slots of all LEDs, in the order in which they were added.
+     */
+    const QVector<int> &displayOrder() const;
+
+    /**
+     * @brief Gets the position of an LED in the display order.
+     * @details The sequential number shown to the user is this position plus one. Compacts the append log first if needed.
+     * @param slot The slot of the LED. Must be live.
+     * @return int The zero-based display position.
+     */
+    int displayIndex(int slot) const;
+
+    /**
+     * @brief Gets the color of an LED as a QColor.
+     * @param slot The slot of the LED.
+     * @return QColor The color of the LED. An LED that is off is transparent.
+     */
+    QColor color(int slot) const;
+
+    /**
+     * @brief Sets the color of an LED from a QColor.
+     * @details Only the color is written; the on/off state is updated separately. The color is stored with 8 bits per channel.
+     * @param slot The slot of the LED.
+     * @param color The new color.
+     */
+    void setColor(int slot, const QColor &color);
+
+    /**
+     * @brief Gets the packed color of an LED.
+     * @param slot The slot of the LED.
+     * @return QRgb The color of the LED as ARGB32.
+     */
+    QRgb rgba(int slot) const;
+
+    /**
+     * @brief Sets the packed color of an LED.
+     * @details Only the color is written; the on/off state is updated separately. While the store is paletted, the color is interned into the palette, which is O(1); a run of writes of the same color skips even the lookup.
+     * @param slot The slot of the LED.
+     * @param rgba The new color as ARGB32.
+     */
+    void setRgba(int slot, QRgb rgba);
+
+    /**
+     * @brief Gives every LED of one color another color.
+     * @details While the store is paletted, this rewrites one palette entry, so the cost does not depend on the number of LEDs; only if the new color already has an entry of its own are the two entries merged in one pass over the indices. Otherwise every live LED is checked. The on/off state is not touched, so neither color may be transparent. In palette mode, the LEDs that changed are not known individually, so everything is marked dirty.
+     * @param from The color to replace.
+     * @param to The new color.
+     * @return int The number of LEDs that changed color.
+     */
+    int replaceColor(QRgb from, QRgb to);
+
+    /**
+     * @brief Gets the number of colors in the palette.
+     * @return int The number of palette entries in use, including transparent, or 0 once the store keeps one color per LED.
+     */
+    int paletteSize() const;
+
+    /**
+     * @brief Checks if an LED is on.
+     * @param slot The slot of the LED.
+     * @return bool True if the LED is on, false otherwise.
+     */
+    bool isOn(int slot) const;
+
+    /**
+     * @brief Sets the on/off state of an LED.
+     * @details Updates the on and blinking counts.
+     * @param slot The slot of the LED.
+     * @param state True to mark the LED as on, false to mark it as off.
+     */
+    void setOn(int slot, bool state);
+
+    /**
+     * @brief Gets the blink period of an LED.
+     * @param slot The slot of the LED.
+     * @return int The blink period in milliseconds, or 0 if the LED does not blink.
+     */
+    int blinkPeriod(int slot) const;
+
+    /**
+     * @brief Turns a range of slots on or off at once.
+     * @details Works on whole words of the on/off set and updates the on and blinking counts by population count, so the cost is one word operation per 64 slots. Only live slots are turned on; colors, blink periods and phases are left alone.
+     * @param first The first slot of the range.
+     * @param count The number of slots in the range. The range is clipped to the existing slots.
+     * @param state True to mark the LEDs as on, false to mark them as off.
+     */
+    void setOnRange(int first, int count, bool state);
+
+    /**
+     * @brief Sets the blink period of an LED.
+     * @details Updates the blinking count.
+     * @param slot The slot of the LED.
+     * @param period The blink period in milliseconds, or 0 to stop blinking.
+     */
+    void setBlinkPeriod(int slot, int period);
+
+    /**
+     * @brief Checks which half of its blink cycle an LED is in.
+     * @param slot The slot of the LED.
+     * @return bool True if the LED is in the lit half, false if it is in the dimmed half.
+     */
+    bool blinkPhase(int slot) const;
+
+    /**
+     * @brief Sets the blink phase of an LED.
+     * @details Marks the LED dirty if the phase changed.
+     * @param slot The slot of the LED.
+     * @param lit True for the lit half of the cycle, false for the dimmed half.
+     */
+    void setBlinkPhase(int slot, bool lit);
+
+    /**
+     * @brief Sets the blink phases of 64 slots at once.
+     * @details Marks every slot whose phase changed dirty, with one word operation.
+     * @param word The index of the word in the blink phase set.
+     * @param lit The new phases, with the bits past slotCount() clear.
+     * @return bool True if at least one phase changed.
+     */
+    bool setBlinkPhaseWord(int word, quint64 lit);
+
+    /**
+     * @brief Gives read access to the dirty flags.
+     * @return const BitSet& The set of slotCount() flags, set for slots whose color or blink phase changed since the last clearDirty(). Free slots may be set as well.
+     */
+    const BitSet &dirtyBits() const;
+
+    /**
+     * @brief Checks if a change affected too many LEDs to track them one by one.
+     * @return bool True if every LED has to be treated as dirty.
+     */
+    bool isAllDirty() const;
+
+    /**
+     * @brief Marks an LED dirty without changing it.
+     * @details For changes to what is derived from the LED rather than to the LED itself, such as the color an effect shows on it.
+     * @param slot The slot of the LED.
+     */
+    void markDirty(int slot);
+
+    /**
+     * @brief Marks every LED dirty without changing any of them.
+     * @details For changes to what is derived from all LEDs at once, such as an effect stopping.
+     */
+    void markAllDirty();
+
+    /**
+     * @brief Clears the dirty flags.
+     * @details Called once the changes have been handed to the view.
+     */
+    void clearDirty();
+
+    /**
+     * @brief Gets the time at which an LED turns itself off.
+     * @param slot The slot of the LED.
+     * @return qint64 The deadline on the store's clock in milliseconds, or -1 if no duration is set.
+     */
+    qint64 offDeadline(int slot) const;
+
+    /**
+     * @brief Sets the time at which an LED turns itself off.
+     * @details Arms or cancels the LED's entry in the timing wheel and updates the timed count, all in O(1).
+     * @param slot The slot of the LED.
+     * @param deadline The deadline on the store's clock in milliseconds, or -1 to cancel it.
+     */
+    void setOffDeadline(int slot, qint64 deadline);
+
+    /**
+     * @brief Cancels the off-deadline of every LED.
+     */
+    void cancelAllOffDeadlines();
+
+    /**
+     * @brief Gets the time at which pending off-deadlines next need processing.
+     * @details Never later than the earliest pending off-deadline; it may be earlier when the timing wheel has to cascade first.
+     * @return qint64 The time on the store's clock in milliseconds, or -1 if no LED has a pending off-deadline.
+     */
+    qint64 nextOffDeadline() const;
+
+    /**
+     * @brief Collects every LED whose off-deadline has passed.
+     * @details Advances the timing wheel to the current time, clears the off-deadline of every expired LED and appends their slots to the output vector. The LEDs themselves are not switched off.
+     * @param expired Vector receiving the slots of the expired LEDs.
+     * @return int The number of LEDs that expired.
+     */
+    int expireOffDeadlines(QVector<int> &expired);
+
+    /**
+     * @brief Gets the current time on the store's monotonic clock.
+     * @return qint64 Milliseconds since the store was created.
+     */
+    qint64 now() const;
+
+    /**
+     * @brief Gives read access to the liveness flags.
+     * @return const BitSet& The set of slotCount() flags, set for live slots.
+     */
+    const BitSet &liveBits() const;
+
+    /**
+     * @brief Gives read access to the on/off flags.
+     * @return const BitSet& The set of slotCount() flags, set for LEDs that are on.
+     */
+    const BitSet &onBits() const;
+
+    /**
+     * @brief Gives read access to the flags of LEDs with a blink period.
+     * @details An LED blinks where this set and the on/off set are both set.
+     * @return const BitSet& The set of slotCount() flags, set for LEDs whose blink period is positive.
+     */
+    const BitSet &periodicBits() const;
+
+    /**
+     * @brief Gives read access to the blink period array.
+     * @return const int* Pointer to the first of slotCount() periods in milliseconds.
+     */
+    const int *blinkPeriodData() const;
+
+    /**
+     * @brief Gives read access to the blink phase flags.
+     * @return const BitSet& The set of slotCount() phases, set for the lit half and clear for the dimmed half.
+     */
+    const BitSet &blinkPhaseBits() const;
+
+    /**
+     * @brief Gives read access to the off-deadline array.
+     * @return const qint64* Pointer to the first of slotCount() deadlines, -1 where no duration is set.
+     */
+    const qint64 *offDeadlineData() const;
+
+private:
+
+    int liveCount = 0; // Number of live slots.
+    int onTotal = 0; // Number of LEDs that are on.
+    int blinkingTotal = 0; // Number of LEDs that are on and have a blink period.
+    int timedTotal = 0; // Number of LEDs with a pending off-deadline.
+    BitSet live; // Set for each slot holding an LED, clear for free slots.
+    QVector<int> generations; // Generation of each slot, bumped on removal. Never shrinks, so handles stay stale after clear().
+    QVector<int> freeSlots; // Free slots, the most recently freed last.
+    bool paletted = true; // Whether colors are kept as palette indices rather than one QRgb per LED.
+    QVector<QRgb> colors; // Color of each LED, while the store is not paletted.
+    QVector<quint8> colorIndices; // Palette entry of each LED, while the store is paletted.
+    QVector<QRgb> palette; // Color of each palette entry. Entry 0 is always transparent.
+    QVector<int> paletteUses; // Number of slots using each palette entry; free entries have none.
+    QHash<QRgb, int> paletteLookup; // Palette entry of each color in use.
+    QVector<int> freeEntries; // Palette entries that no slot uses.
+    QRgb lastRgba = Transparent; // Color interned last.
+    int lastEntry = 0; // Palette entry of the color interned last.
+    BitSet on; // On/off state of each LED.
+    QVector<int> blinkPeriods; // Blink period of each LED in milliseconds, 0 if not blinking.
+    BitSet periodic; // Set for each LED whose blink period is positive.
+    BitSet blinkPhases; // Blink phase of each LED, set for the lit half of the cycle.
+    BitSet dirty; // Set for each slot whose color or blink phase changed since the last clearDirty().
+    bool allDirty = false; // Whether a change affected LEDs that were not marked one by one.
+    QVector<qint64> offDeadlines; // Time at which each LED turns off, -1 if no duration is set.
+    TimingWheel offWheel; // Index of the pending off-deadlines, keyed by slot.
+    QElapsedTimer clock; // Monotonic clock for off-deadlines.
+    mutable QVector<int> order; // Append log of slots; entries of removed LEDs stay until the next compaction.
+    mutable QVector<int> orderIndex; // Position of each live slot's current entry in the append log.
+    mutable int staleEntries = 0; // Number of entries in the append log that belong to removed LEDs.
+
+    /**
+     * @brief Empties the palette except for the transparent entry and makes the store paletted again.
+     * @details Only valid while no slot exists.
+     */
+    void resetPalette();
+
+    /**
+     * @brief Finds the palette entry of a color.
+     * @param rgba The color.
+     * @return int The entry, or -1 if the color is not in the palette.
+     */
+    int findEntry(QRgb rgba);
+
+    /**
+     * @brief Adds a color to the palette.
+     * @details Reuses a free entry first.
+     * @param rgba The color, which must not be in the palette yet.
+     * @return int The new entry with no uses, or -1 if the palette is full.
+     */
+    int newEntry(QRgb rgba);
+
+    /**
+     * @brief Drops one use of a palette entry, freeing the entry when it has none left.
+     * @details The transparent entry is never freed.
+     * @param entry The palette entry.
+     */
+    void releaseEntry(int entry);
+
+    /**
+     * @brief Switches from palette indices to one QRgb per LED.
+     */
+    void expandPalette();
+
+    /**
+     * @brief Drops the entries of removed LEDs from the append log.
+     * @details An entry is kept if its slot is live and the slot's current entry is at that position; an older entry of a reused slot is dropped.
+     */
+    void compactOrder() const;
+
+};
+
+#endif // LEDSTORE_H
@@ -0,0 +1,152 @@
+/**
+ * @file OutputFrame.cpp
+ * @brief Implementation of the OutputFrame class.
+ * @details This file contains the implementation of the OutputFrame class, whose update pass fuses reading the store's colors with the color correction, to 8 bits and, while dithering, to 16 bits as well.
+ * @see OutputFrame.h for the declaration of the OutputFrame class.
+ * @author Group 3
+ */
+
+#include "include/models/OutputFrame.h"
+#include "include/utils/Trace.h"
+
+/**
+ * @brief Constructor for OutputFrame.
+ * @param store The store holding the colors to output.
+ */
+OutputFrame::OutputFrame(const LedStore &store) : store(store) {}
+
+/**
+ * @brief Sets the parameters of the color correction.
+ * @param parameters The new parameters.
+ * @return True if the parameters changed.
+ */
+bool OutputFrame::setCorrection(const ColorCorrection::Parameters &parameters) {
+    if (!correctionTables.setParameters(parameters)) {return false;}
+    stale = true;
+    return true;
+}
+
+/**
+ * @brief Gets the color correction.
+ * @return The color correction.
+ */
+const ColorCorrection &OutputFrame::correction() const {
+    return correctionTables;
+}
+
+/**
+ * @brief Enables or disables temporal dithering.
+ * @param enabled True to dither the output colors.
+ * @return True if the setting changed.
+ */
+bool OutputFrame::setDithering(bool enabled) {
+    if (enabled == dithering) {return false;}
+    dithering = enabled;
+    stale = true;
+    return true;
+}
+
+/**
+ * @brief Tells whether temporal dithering is enabled.
+ * @return True if dithering is enabled.
+ */
+bool OutputFrame::isDithering() const {
+    return dithering;
+}
+
+/**
+ * @brief Tells whether dither() has any effect.
+ * @details An identity correction maps every level to a whole 16-bit step, so dithering would never change a color.
+ * @return True if dither() has to be called every frame.
+ */
+bool OutputFrame::isDitheringActive() const {
+    return dithering && !correctionTables.isIdentity();
+}
+
+/**
+ * @brief Brings the frame in line with the store.
+ * @details Dirty slots below the previous size are corrected where they are; the slots from the previous size on are new and corrected in the closing pass, which covers every slot when the whole frame is stale. Free slots are corrected like the others, so the pass needs no liveness test. Residuals of slots that are corrected again are kept as long as the slot holds the same LED; new slots, and slots reused by another LED, start with none.
+ */
+void OutputFrame::update() {
+
+    if (!dithering || correctionTables.isIdentity()) {
+        linear = QVector<quint64>(); // Releasing the dithering state.
+        residuals = QVector<quint32>();
+        owners = QVector<int>();
+    }
+    if (correctionTables.isIdentity()) {
+        colors = QVector<QRgb>(); // Releasing the frame; the store's colors are output as they are.
+        stale = true;
+        return;
+    }
+
+    Trace::Span span("OutputFrame::update");
+    const int count = store.slotCount();
+    int first = colors.size();
+    if (stale || store.isAllDirty() || first > count) {first = 0;}
+
+    colors.resize(count);
+    if (dithering) {
+        linear.resize(count);
+        residuals.resize(count);
+        owners.resize(count); // New slots get 0, which is never a valid handle.
+    }
+    if (first > 0) {
+        const BitSet &dirty = store.dirtyBits();
+        for (int slot = dirty.nextSet(0); slot >= 0 && slot < first; slot = dirty.nextSet(slot + 1)) {correct(slot);}
+    }
+    for (int slot = first; slot < count; ++slot) {correct(slot);}
+    stale = false;
+
+}
+
+/**
+ * @brief Advances the temporal dithering by one frame.
+ */
+void OutputFrame::dither() {
+    if (!isDitheringActive() || linear.isEmpty()) {return;}
+    Trace::Span span("OutputFrame::dither");
+    ColorCorrection::dither(linear.constData(), residuals.data(), colors.data(), linear.size());
+}
+
+/**
+ * @brief Sets the color the running effect shows on an LED.
+ * @details The layer grows to the store's slots on demand; slots it did not cover yet start transparent, which only shows for LEDs that are on, until the next frame.
+ * @param slot The slot of the LED.
+ * @param rgba The color.
+ * @return True if the color changed.
+ */
+bool OutputFrame::setEffectColor(int slot, QRgb rgba) {
+    if (slot >= effectColors.size()) {effectColors.resize(store.slotCount());}
+    if (effectColors.at(slot) == rgba) {return false;}
+    effectColors[slot] = rgba;
+    return true;
+}
+
+/**
+ * @brief Removes the effect layer.
+ * @return True if the layer was set.
+ */
+bool OutputFrame::clearEffect() {
+    if (effectColors.isEmpty()) {return false;}
+    effectColors = QVector<QRgb>(); // Releasing the layer.
+    return true;
+}
+
+/**
+ * @brief Corrects the color of one slot.
+ * @details Reads the source color once for both the 8-bit and the 16-bit correction. A slot whose handle changed holds another LED, whose dithering starts over.
+ * @param slot The slot.
+ */
+void OutputFrame::correct(int slot) {
+    const QRgb rgba = source(slot);
+    colors[slot] = correctionTables.map(rgba);
+    if (dithering) {
+        linear[slot] = correctionTables.mapLinear(rgba);
+        const int handle = store.handleOf(slot);
+        if (owners.at(slot) != handle) { // The slot was freed and reused since it was last corrected.
+            owners[slot] = handle;
+            residuals[slot] = 0;
+        }
+    }
+}
@@ -0,0 +1,137 @@
+/**
+ * @file OutputFrame.h
+ * @brief Defines the OutputFrame class, which holds the colors the LEDs output.
+ * @details This header file contains the declaration of the OutputFrame class. The store keeps the colors as they were picked; the output frame keeps them as they are shown, with the running effect laid over them and after color correction and temporal dithering, so that changing any of these never loses the picked colors.
+ * @author Group 3
+ */
+
+#ifndef OUTPUTFRAME_H
+#define OUTPUTFRAME_H
+
+#include "include/models/LedStore.h"
+#include "include/utils/ColorCorrection.h"
+
+// Including necessary modules.
+#include <QVector>
+
+/**
+ * @class OutputFrame
+ * @brief The corrected color of every LED, indexed by slot.
+ * @details The colors of the running effect are kept in a layer of their own, indexed by slot, which covers the LEDs that are on while the layer is set; the store's colors show through everywhere else, and again once the layer is cleared. update() brings the frame in line with the store and the layer in one pass that reads each color and corrects it through the lookup tables of ColorCorrection. After a change of the correction or a change the store marked as affecting everything, the pass covers every slot; otherwise it only visits the slots in the store's dirty set and the slots appended since the last pass, so it has to run before the dirty flags are cleared. While the correction leaves colors unchanged, no frame is kept and the store's colors are output as they are. With dithering enabled, the same pass also keeps the corrected colors at 16 bits per channel, and dither() replaces the output colors with their temporally dithered 8-bit values once per frame, keeping the residual of each LED in a side array of one byte per channel. The handle each residual belongs to is kept alongside, so that an LED taking over a freed slot does not inherit the removed LED's residual.
+ * @author Group 3
+ */
+class OutputFrame {
+
+public:
+
+    /**
+     * @brief Constructor for OutputFrame.
+     * @details The store is not copied; the caller must keep it alive for the lifetime of the frame.
+     * @param store The store holding the colors to output.
+     */
+    explicit OutputFrame(const LedStore &store);
+
+    /**
+     * @brief Sets the parameters of the color correction.
+     * @details Unchanged parameters leave the tables and the frame alone; changed ones make the next update() correct every slot.
+     * @param parameters The new parameters.
+     * @return bool True if the parameters changed, so that the whole frame has to be repainted.
+     */
+    bool setCorrection(const ColorCorrection::Parameters &parameters);
+
+    /**
+     * @brief Gets the color correction.
+     * @return const ColorCorrection& The color correction applied to the store's colors.
+     */
+    const ColorCorrection &correction() const;
+
+    /**
+     * @brief Enables or disables temporal dithering.
+     * @details A change makes the next update() correct every slot.
+     * @param enabled True to dither the output colors.
+     * @return bool True if the setting changed.
+     */
+    bool setDithering(bool enabled);
+
+    /**
+     * @brief Tells whether temporal dithering is enabled.
+     * @return bool True if dithering is enabled, even while the correction leaves colors unchanged.
+     */
+    bool isDithering() const;
+
+    /**
+     * @brief Tells whether dither() has any effect.
+     * @return bool True if dithering is enabled and the correction changes colors, so that dither() has to be called every frame.
+     */
+    bool isDitheringActive() const;
+
+    /**
+     * @brief Brings the frame in line with the store.
+     * @details Must be called before the store's dirty flags are cleared. LEDs whose color changed output the rounded corrected color until the next dither().
+     */
+    void update();
+
+    /**
+     * @brief Advances the temporal dithering by one frame.
+     * @details Computes the output color of every slot from its 16-bit color and its residual, as of the last update(); changes to the store since then are not seen until the next one. Does nothing unless isDitheringActive().
+     */
+    void dither();
+
+    /**
+     * @brief Sets the color the running effect shows on an LED.
+     * @details The color only shows while the LED is on. The caller marks the LED dirty in the store if the color changed, so that the next update() corrects it.
+     * @param slot The slot of the LED.
+     * @param rgba The color as ARGB32.
+     * @return bool True if the color differs from the one the effect showed before.
+     */
+    bool setEffectColor(int slot, QRgb rgba);
+
+    /**
+     * @brief Removes the effect layer, so that every LED shows its own color again.
+     * @details The caller marks every LED dirty in the store if the layer was set, so that the next update() corrects them.
+     * @return bool True if the layer was set.
+     */
+    bool clearEffect();
+
+    /**
+     * @brief Gets the output color of an LED.
+     * @details Slots appended since the last update() are corrected on the fly.
+     * @param slot The slot of the LED.
+     * @return QRgb The corrected color as ARGB32.
+     */
+    QRgb rgba(int slot) const {
+        if (correctionTables.isIdentity()) {return source(slot);}
+        return slot < colors.size() ? colors.at(slot) : correctionTables.map(source(slot));
+    }
+
+private:
+
+    const LedStore &store; // Colors as picked or rendered, owned by the caller.
+    ColorCorrection correctionTables; // Correction turning the store's colors into output colors.
+    QVector<QRgb> effectColors; // Color the running effect shows on each slot, empty while no effect runs.
+    QVector<QRgb> colors; // Output color of each slot, empty while the correction leaves colors unchanged.
+    QVector<quint64> linear; // Corrected 16-bit color of each slot, empty while dithering is inactive.
+    QVector<quint32> residuals; // Dithering residual of each slot, one byte per channel, empty while dithering is inactive.
+    QVector<int> owners; // Handle of the LED each residual belongs to, empty while dithering is inactive.
+    bool dithering = false; // Whether dithering is enabled.
+    bool stale = true; // Whether every slot has to be corrected again.
+
+    /**
+     * @brief Gets the color of an LED before correction.
+     * @param slot The slot of the LED.
+     * @return QRgb The effect's color if the LED is on and the effect covers it, otherwise the store's color.
+     */
+    QRgb source(int slot) const {
+        return slot < effectColors.size() && store.isOn(slot) ? effectColors.at(slot) : store.rgba(slot);
+    }
+
+    /**
+     * @brief Corrects the color of one slot.
+     * @details While dithering, also drops the residual if the slot holds a different LED than when it was last corrected.
+     * @param slot The slot.
+     */
+    void correct(int slot);
+
+};
+
+#endif // OUTPUTFRAME_H
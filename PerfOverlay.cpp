@@ -0,0 +1,102 @@
+/**
+ * @file PerfOverlay.cpp
+ * @brief Implementation of the PerfOverlay class.
+ * @details This file contains the implementation of the PerfOverlay class, which formats the figures collected by FrameStats together with the number of live timers and LEDs.
+ * @see PerfOverlay.h for the declaration of the PerfOverlay class.
+ * @author Group 3
+ */
+
+#include "include/interfaces/PerfOverlay.h"
+#include "include/models/BlinkScheduler.h"
+#include "include/utils/Trace.h"
+
+// Including necessary modules.
+#include <QPalette>
+
+namespace {
+
+/**
+ * @brief Formats a duration in milliseconds.
+ * @param nanoseconds The duration in nanoseconds.
+ * @return The duration with two decimals.
+ */
+QString milliseconds(qint64 nanoseconds) {
+    return QString::number(nanoseconds / 1e6, 'f', 2);
+}
+
+}
+
+/**
+ * @brief Constructs a PerfOverlay.
+ * @details Uses an opaque palette background instead of a style sheet, and makes the overlay transparent for mouse events so that clicks reach the LEDs underneath.
+ * @param view The view to measure.
+ * @param store The store whose LEDs are counted.
+ * @param timerRoot The object whose descendant timers are counted.
+ */
+PerfOverlay::PerfOverlay(LedMatrixView *view, const LedStore &store, QObject *timerRoot) : QLabel(view), view(view), store(store), timerRoot(timerRoot) {
+
+    QPalette colors = palette();
+    colors.setColor(QPalette::Window, Qt::black);
+    colors.setColor(QPalette::WindowText, Qt::white);
+    setPalette(colors);
+    setAutoFillBackground(true);
+    setMargin(6);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    move(0, 0);
+    hide();
+
+    refreshTimer.setInterval(1000);
+    connect(&refreshTimer, &QTimer::timeout, this, &PerfOverlay::refresh);
+
+}
+
+/**
+ * @brief Starts measuring when the overlay is shown.
+ * @details The first figures appear after one second; until then the overlay says so.
+ * @param event The show event.
+ */
+void PerfOverlay::showEvent(QShowEvent *event) {
+    QLabel::showEvent(event);
+    stats.take(); // Discarding anything left from an earlier period.
+    view->setFrameStats(&stats);
+    refreshTimer.start();
+    setText("Measuring...");
+    adjustSize();
+    raise(); // Staying above the viewport.
+}
+
+/**
+ * @brief Stops measuring when the overlay is hidden.
+ * @param event The hide event.
+ */
+void PerfOverlay::hideEvent(QHideEvent *event) {
+    QLabel::hideEvent(event);
+    view->setFrameStats(nullptr);
+    refreshTimer.stop();
+}
+
+/**
+ * @brief Shows the figures of the last second.
+ * @details Paints of the view are taken as frames, and the pixels they cover are shown as an average per frame and as a share of the viewport, which shows whether repaints stay limited to the LEDs that changed. Timers are counted by walking the children of the timer root, which happens once per second and only while the overlay is shown.
+ */
+void PerfOverlay::refresh() {
+
+    Trace::Span span("PerfOverlay::refresh");
+
+    BlinkScheduler::countWakeup(); // This refresh is a wakeup as well.
+    const FrameStats::Summary summary = stats.take();
+
+    int timers = 0;
+    const QList<QTimer*> children = timerRoot->findChildren<QTimer*>();
+    for (const QTimer *timer : children) {if (timer->isActive()) {++timers;}}
+
+    const qint64 perFrame = summary.paints > 0 ? summary.pixels / summary.paints : 0;
+    const qint64 viewArea = qMax<qint64>(1, qint64(view->viewport()->width()) * view->viewport()->height());
+
+    setText(QString("Frames/s: %1\nPaint p50/p95/p99: %2 / %3 / %4 ms\nPixels/frame: %5 (%6% of view)\nLayout passes/s: %7\nLive timers: %8\nLEDs: %9")
+            .arg(summary.paints).arg(milliseconds(summary.p50), milliseconds(summary.p95), milliseconds(summary.p99))
+            .arg(perFrame).arg(QString::number(100.0 * perFrame / viewArea, 'f', 1))
+            .arg(summary.layouts).arg(timers).arg(store.size()));
+    adjustSize();
+
+}
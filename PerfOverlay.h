@@ -0,0 +1,71 @@
+/**
+ * @file PerfOverlay.h
+ * @brief Defines the PerfOverlay class, a label showing live performance figures over the LED view.
+ * @details This header file contains the declaration of the PerfOverlay class. It is only built when PILLUMINATE_PERF_OVERLAY is defined, which the project file does unless qmake is run with CONFIG+=no_perf_overlay.
+ * @author Group 3
+ */
+
+#ifndef PERFOVERLAY_H
+#define PERFOVERLAY_H
+
+#include "include/interfaces/LedMatrixView.h"
+#include "include/models/LedStore.h"
+#include "include/utils/FrameStats.h"
+
+// Including necessary modules.
+#include <QLabel>
+#include <QTimer>
+
+/**
+ * @class PerfOverlay
+ * @brief Shows frames per second, paint time percentiles, layout passes per second, live timers and LEDs.
+ * @details The overlay sits in the top-left corner of the LED view and refreshes once per second. It only measures while it is visible: showing it attaches its FrameStats to the view and starts its timer, hiding it detaches them again, so a hidden overlay costs nothing. It is opaque, so refreshing its text does not make the view repaint the LEDs beneath it, and it lets mouse events through to the LEDs.
+ * @author Group 3
+ */
+class PerfOverlay : public QLabel {
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructor for PerfOverlay.
+     * @details Creates the overlay hidden, as a child of the view.
+     * @param view The view to measure.
+     * @param store The store whose LEDs are counted.
+     * @param timerRoot The object whose descendant timers are counted.
+     */
+    PerfOverlay(LedMatrixView *view, const LedStore &store, QObject *timerRoot);
+
+protected:
+
+    /**
+     * @brief Starts measuring when the overlay is shown.
+     * @param event The show event.
+     */
+    void showEvent(QShowEvent *event) override;
+
+    /**
+     * @brief Stops measuring when the overlay is hidden.
+     * @param event The hide event.
+     */
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+
+    /**
+     * @brief Shows the figures of the last second.
+     */
+    void refresh();
+
+private:
+
+    LedMatrixView *view; // View whose paints and layout passes are measured.
+    const LedStore &store; // Store whose LEDs are counted.
+    QObject *timerRoot; // Object whose active descendant timers are counted.
+    FrameStats stats; // Measurements of the current second.
+    QTimer refreshTimer; // Timer refreshing the figures once per second.
+
+};
+
+#endif // PERFOVERLAY_H
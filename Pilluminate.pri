@@ -0,0 +1,61 @@
+# Sources shared by the application and the test projects, which include this file from their own directories.
+
+QT += core gui widgets network
+
+CONFIG += c++11
+
+SOURCES += $$PWD/src/interfaces/CommandInterface.cpp \
+           $$PWD/src/interfaces/LedMatrixView.cpp \
+           $$PWD/src/interfaces/SpriteCache.cpp \
+           $$PWD/src/interfaces/UserInterface.cpp \
+           $$PWD/src/models/BitSet.cpp \
+           $$PWD/src/models/BlinkScheduler.cpp \
+           $$PWD/src/models/DurationScheduler.cpp \
+           $$PWD/src/models/EffectEngine.cpp \
+           $$PWD/src/models/Effects.cpp \
+           $$PWD/src/models/LedController.cpp \
+           $$PWD/src/models/LedStore.cpp \
+           $$PWD/src/models/OutputFrame.cpp \
+           $$PWD/src/models/TimingWheel.cpp \
+           $$PWD/src/models/VirtualLED.cpp \
+           $$PWD/src/utils/ColorCorrection.cpp \
+           $$PWD/src/utils/ColorSpaces.cpp \
+           $$PWD/src/utils/CpuFeatures.cpp \
+           $$PWD/src/utils/EffectKernels.cpp \
+           $$PWD/src/utils/EventLog.cpp \
+           $$PWD/src/utils/Trace.cpp
+
+HEADERS += $$PWD/include/interfaces/CommandInterface.h \
+           $$PWD/include/interfaces/LedMatrixView.h \
+           $$PWD/include/interfaces/SpriteCache.h \
+           $$PWD/include/interfaces/UserInterface.h \
+           $$PWD/include/models/BitSet.h \
+           $$PWD/include/models/BlinkScheduler.h \
+           $$PWD/include/models/DurationScheduler.h \
+           $$PWD/include/models/Effect.h \
+           $$PWD/include/models/EffectEngine.h \
+           $$PWD/include/models/Effects.h \
+           $$PWD/include/models/LedController.h \
+           $$PWD/include/models/LedStore.h \
+           $$PWD/include/models/OutputFrame.h \
+           $$PWD/include/models/TimingWheel.h \
+           $$PWD/include/models/VirtualLED.h \
+           $$PWD/include/utils/ColorCorrection.h \
+           $$PWD/include/utils/ColorSpaces.h \
+           $$PWD/include/utils/CpuFeatures.h \
+           $$PWD/include/utils/EffectKernels.h \
+           $$PWD/include/utils/EventLog.h \
+           $$PWD/include/utils/Trace.h \
+           $$PWD/include/utils/TripleBuffer.h
+
+# The performance overlay (F3) is built unless qmake is run with CONFIG+=no_perf_overlay.
+!no_perf_overlay {
+    DEFINES += PILLUMINATE_PERF_OVERLAY
+    SOURCES += $$PWD/src/interfaces/PerfOverlay.cpp \
+               $$PWD/src/utils/FrameStats.cpp
+    HEADERS += $$PWD/include/interfaces/PerfOverlay.h \
+               $$PWD/include/utils/FrameStats.h
+}
+
+# Add the include paths for headers; sources include them as include/<module>/<name>.h.
+INCLUDEPATH += $$PWD $$PWD/include
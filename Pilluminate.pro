@@ -1,17 +1,7 @@
-QT += core gui widgets
+# The application and its tests. "make check" runs the tests, "make benchmark" runs the benchmarks.
+TEMPLATE = subdirs
 
-CONFIG += c++11
-
-TARGET = Pilluminate
-TEMPLATE = app
-
-SOURCES += src/interfaces/UserInterface.cpp \
-           src/models/VirtualLED.cpp \
-           src/main.cpp
-
-HEADERS += include/interfaces/UserInterface.h \
-           include/models/VirtualLED.h \
-
-# Add the include path for headers
-INCLUDEPATH += $$PWD/include
+SUBDIRS += app \
+           tests
 
+app.file = app.pro
@@ -0,0 +1,91 @@
+/**
+ * @file SpriteCache.cpp
+ * @brief Implementation of the SpriteCache class.
+ * @details This file contains the implementation of the SpriteCache class, including the packing of sprite keys and the rendering of new sprites.
+ * @see SpriteCache.h for the declaration of the SpriteCache class.
+ * @author Group 3
+ */
+
+#include "include/interfaces/SpriteCache.h"
+
+// Including necessary modules.
+#include <QColor>
+#include <QPainter>
+
+namespace {
+
+/**
+ * @brief Packs the properties of a sprite into a cache key.
+ * @details The color takes the low 32 bits as ARGB, the size the next 16 and the device pixel ratio, in 64ths, the top 16. No key is 0, since the ratio is always positive.
+ * @param rgba The color of the LED.
+ * @param size The size of the sprite.
+ * @param devicePixelRatio The device pixel ratio.
+ * @return The key.
+ */
+quint64 keyOf(QRgb rgba, int size, qreal devicePixelRatio) {
+    const quint64 ratio = quint64(qMax(1, qRound(devicePixelRatio * 64))) & 0xffff;
+    return (ratio << 48) | (quint64(size & 0xffff) << 32) | rgba;
+}
+
+}
+
+/**
+ * @brief Constructs a SpriteCache.
+ * @param maxBytes The maximum total size of the cached pixmaps.
+ */
+SpriteCache::SpriteCache(int maxBytes) : sprites(maxBytes) {}
+
+/**
+ * @brief Gets the sprite of an LED.
+ * @details The sprite is rendered at the device resolution, so that it is blitted without scaling. The color only becomes a QColor when a new sprite is rendered.
+ * @param rgba The color the LED is drawn with.
+ * @param size The width and height of the sprite.
+ * @param devicePixelRatio The device pixel ratio of the target.
+ * @return The sprite.
+ */
+QPixmap SpriteCache::sprite(QRgb rgba, int size, qreal devicePixelRatio) {
+
+    const quint64 key = keyOf(rgba, size, devicePixelRatio);
+    if (key == lastKey) {return lastSprite;}
+
+    if (QPixmap *cached = sprites.object(key)) {
+        lastKey = key;
+        lastSprite = *cached;
+        return lastSprite;
+    }
+
+    QPixmap pixmap(QSize(size, size) * devicePixelRatio);
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+    pixmap.fill(Qt::transparent);
+    {
+        QPainter painter(&pixmap);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::black);
+        painter.setBrush(QColor::fromRgba(rgba));
+        painter.drawEllipse(QRect(1, 1, size - 2, size - 2)); // Same geometry as the cell adjusted for the border.
+    }
+
+    const int cost = pixmap.width() * pixmap.height() * pixmap.depth() / 8;
+    sprites.insert(key, new QPixmap(pixmap), cost); // Evicting the least recently used sprites if needed.
+    lastKey = key;
+    lastSprite = pixmap;
+    return pixmap;
+
+}
+
+/**
+ * @brief Removes every sprite.
+ */
+void SpriteCache::clear() {
+    sprites.clear();
+    lastKey = 0;
+    lastSprite = QPixmap();
+}
+
+/**
+ * @brief Gets the number of cached sprites.
+ * @return The number of sprites.
+ */
+int SpriteCache::count() const {
+    return int(sprites.count());
+}
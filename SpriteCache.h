@@ -0,0 +1,61 @@
+/**
+ * @file SpriteCache.h
+ * @brief Defines the SpriteCache class, which keeps pre-rendered LED images.
+ * @details This header file contains the declaration of the SpriteCache class. Rasterizing an antialiased ellipse is far more expensive than copying a small pixmap, so LedMatrixView renders every distinct LED look once into a sprite and blits the sprite afterwards.
+ * @author Group 3
+ */
+
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+// Including necessary modules.
+#include <QCache>
+#include <QPixmap>
+#include <QRgb>
+
+/**
+ * @class SpriteCache
+ * @brief Bounded least-recently-used cache of LED sprites.
+ * @details A sprite is identified by the color it is drawn with, its size and the device pixel ratio it is rendered for. The blink phase is part of the color, since the dimmed phase is drawn with a reduced alpha, so a lit and a dimmed LED of the same color get separate sprites. The cache is bounded by the total number of bytes of its pixmaps and evicts the least recently used sprites first, so sessions with many unique colors keep a fixed memory footprint.
+ * @author Group 3
+ */
+class SpriteCache {
+
+public:
+
+    /**
+     * @brief Constructor for SpriteCache.
+     * @param maxBytes The maximum total size of the cached pixmaps.
+     */
+    explicit SpriteCache(int maxBytes = 16 * 1024 * 1024);
+
+    /**
+     * @brief Gets the sprite of an LED.
+     * @details Renders the sprite on first use. The LED is a circle filling the sprite with a one-pixel margin, outlined in black and filled with the color.
+     * @param rgba The color the LED is drawn with as ARGB32, including its alpha.
+     * @param size The width and height of the sprite in device-independent pixels.
+     * @param devicePixelRatio The device pixel ratio of the target.
+     * @return QPixmap The sprite, with its device pixel ratio set.
+     */
+    QPixmap sprite(QRgb rgba, int size, qreal devicePixelRatio);
+
+    /**
+     * @brief Removes every sprite.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of cached sprites.
+     * @return int The number of sprites.
+     */
+    int count() const;
+
+private:
+
+    QCache<quint64, QPixmap> sprites; // Sprites by key, with their size in bytes as cost.
+    quint64 lastKey = 0; // Key of the sprite returned last.
+    QPixmap lastSprite; // Sprite returned last, so that runs of equal LEDs skip the lookup.
+
+};
+
+#endif // SPRITECACHE_H
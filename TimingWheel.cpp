@@ -0,0 +1,248 @@
+/**
+ * @file TimingWheel.cpp
+ * @brief Implementation of the TimingWheel class.
+ * @details This file contains the implementation of the TimingWheel class, including bucket placement, cascading of higher-level buckets and the expiry pass. Deadlines too far ahead for the top level are parked in an overflow bucket that is re-placed each time the top level wraps around.
+ * @see TimingWheel.h for the declaration of the TimingWheel class.
+ * @author Group 3
+ */
+
+#include "include/models/TimingWheel.h"
+
+// Including necessary modules.
+#include <QtAlgorithms>
+
+namespace {
+
+const int OverflowBucket = 4 * 64; // Bucket for deadlines beyond the top level.
+const int WheelBits = 4 * 6; // Number of time bits resolved by all levels together.
+
+}
+
+/**
+ * @brief Constructs an empty TimingWheel.
+ */
+TimingWheel::TimingWheel() : current(0), pending(0) {
+    clear();
+}
+
+/**
+ * @brief Adds a key at the end of the key range.
+ */
+void TimingWheel::appendKey() {
+    deadlines.append(0);
+    buckets.append(-1);
+    next.append(-1);
+    prev.append(-1);
+}
+
+/**
+ * @brief Removes every key and every pending deadline.
+ */
+void TimingWheel::clear() {
+    deadlines.clear();
+    buckets.clear();
+    next.clear();
+    prev.clear();
+    cancelAll();
+}
+
+/**
+ * @brief Reserves memory for a number of keys.
+ * @param count The number of keys to reserve space for.
+ */
+void TimingWheel::reserve(int count) {
+    deadlines.reserve(count);
+    buckets.reserve(count);
+    next.reserve(count);
+    prev.reserve(count);
+}
+
+/**
+ * @brief Sets the deadline of a key, replacing any pending one.
+ * @param key The key to arm.
+ * @param deadline The deadline in ticks.
+ */
+void TimingWheel::arm(int key, qint64 deadline) {
+    if (buckets.at(key) >= 0) {unlink(key);}
+    else {++pending;}
+    deadlines[key] = deadline;
+    place(key);
+}
+
+/**
+ * @brief Cancels the pending deadline of a key, if any.
+ * @param key The key to cancel.
+ */
+void TimingWheel::cancel(int key) {
+    if (buckets.at(key) < 0) {return;}
+    unlink(key);
+    buckets[key] = -1;
+    --pending;
+}
+
+/**
+ * @brief Cancels every pending deadline while keeping the keys.
+ */
+void TimingWheel::cancelAll() {
+    buckets.fill(-1);
+    for (int &head : heads) {head = -1;}
+    for (quint64 &bits : occupied) {bits = 0;}
+    pending = 0;
+}
+
+/**
+ * @brief Checks if a key has a pending deadline.
+ * @param key The key to check.
+ * @return True if the key is armed, false otherwise.
+ */
+bool TimingWheel::isArmed(int key) const {
+    return buckets.at(key) >= 0;
+}
+
+/**
+ * @brief Gets the number of pending deadlines.
+ * @return The number of armed keys.
+ */
+int TimingWheel::pendingCount() const {
+    return pending;
+}
+
+/**
+ * @brief Gets the time at which the wheel next needs to advance.
+ * @details Level 0 buckets hold deadlines; the first non-empty one gives the earliest deadline. On higher levels, the first non-empty bucket gives the time at which it must be cascaded. Both are found with one bit scan per level.
+ * @return The time in ticks, or -1 if nothing is pending.
+ */
+qint64 TimingWheel::nextEventTime() const {
+
+    if (pending == 0) {return -1;}
+
+    qint64 earliest = -1;
+
+    for (int level = 0; level < Levels; ++level) {
+        if (!occupied[level]) {continue;}
+        const int shift = level * BucketBits;
+        const qint64 span = qint64(1) << (shift + BucketBits);
+        const qint64 index = qCountTrailingZeroBits(occupied[level]);
+        const qint64 time = (current & ~(span - 1)) | (index << shift);
+        if (earliest < 0 || time < earliest) {earliest = time;}
+    }
+
+    if (heads[OverflowBucket] >= 0) { // Overflow is re-placed when the top level wraps around.
+        const qint64 time = ((current >> WheelBits) + 1) << WheelBits;
+        if (earliest < 0 || time < earliest) {earliest = time;}
+    }
+
+    return earliest;
+
+}
+
+/**
+ * @brief Advances the current time and collects every expired key.
+ * @details Jumps from event to event rather than from tick to tick. At each event, due higher-level buckets are cascaded from the top down, then the level 0 bucket of the current tick is expired.
+ * @param now The new current time in ticks.
+ * @param expired Vector receiving the expired keys.
+ * @return The number of keys that expired.
+ */
+int TimingWheel::advance(qint64 now, QVector<int> &expired) {
+
+    int count = 0;
+
+    forever {
+
+        const qint64 time = nextEventTime();
+        if (time < 0 || time > qMax(now, current)) {break;}
+        current = time;
+
+        // Cascading every bucket whose start is the current time, highest level first.
+        if ((current & ((qint64(1) << WheelBits) - 1)) == 0 && heads[OverflowBucket] >= 0) {cascade(Levels, 0);}
+        for (int level = Levels - 1; level > 0; --level) {
+            const int shift = level * BucketBits;
+            if ((current & ((qint64(1) << shift) - 1)) != 0) {continue;}
+            const int index = int((current >> shift) & (Buckets - 1));
+            if (occupied[level] & (quint64(1) << index)) {cascade(level, index);}
+        }
+
+        // Expiring the level 0 bucket of the current tick.
+        const int index = int(current & (Buckets - 1));
+        int key = heads[index];
+        heads[index] = -1;
+        occupied[0] &= ~(quint64(1) << index);
+        while (key >= 0) {
+            const int following = next[key];
+            buckets[key] = -1;
+            expired.append(key);
+            --pending;
+            ++count;
+            key = following;
+        }
+
+    }
+
+    if (now > current) {current = now;} // No events in between, so the wheel can jump ahead.
+    return count;
+
+}
+
+/**
+ * @brief Places an armed key into the bucket matching its deadline.
+ * @details The level is given by the highest 6-bit digit in which the deadline differs from the current time. Deadlines at or before the current time go into the current level 0 bucket.
+ * @param key The key to place.
+ */
+void TimingWheel::place(int key) {
+
+    const qint64 deadline = deadlines.at(key);
+    int bucket;
+
+    if (deadline <= current) {bucket = int(current & (Buckets - 1));}
+    else {
+        const int highestBit = 63 - qCountLeadingZeroBits(quint64(deadline ^ current));
+        const int level = highestBit / BucketBits;
+        if (level >= Levels) {bucket = OverflowBucket;}
+        else {bucket = level * Buckets + int((deadline >> (level * BucketBits)) & (Buckets - 1));}
+    }
+
+    // Linking the key at the head of the bucket.
+    buckets[key] = bucket;
+    prev[key] = -1;
+    next[key] = heads[bucket];
+    if (heads[bucket] >= 0) {prev[heads[bucket]] = key;}
+    heads[bucket] = key;
+    if (bucket != OverflowBucket) {occupied[bucket / Buckets] |= quint64(1) << (bucket % Buckets);}
+
+}
+
+/**
+ * @brief Removes a key from its bucket without changing its deadline.
+ * @param key The key to unlink.
+ */
+void TimingWheel::unlink(int key) {
+
+    const int bucket = buckets.at(key);
+    if (prev[key] >= 0) {next[prev[key]] = next[key];}
+    else {heads[bucket] = next[key];}
+    if (next[key] >= 0) {prev[next[key]] = prev[key];}
+
+    if (heads[bucket] < 0 && bucket != OverflowBucket) {occupied[bucket / Buckets] &= ~(quint64(1) << (bucket % Buckets));}
+
+}
+
+/**
+ * @brief Moves every key in one higher-level bucket down to the lower levels.
+ * @details Since the current time now equals the start of the bucket, every key in it lands on a lower level (or in the current level 0 bucket if it is already due).
+ * @param level The level of the bucket, or Levels for the overflow bucket.
+ * @param index The index of the bucket within its level.
+ */
+void TimingWheel::cascade(int level, int index) {
+
+    const int bucket = level * Buckets + index;
+    int key = heads[bucket];
+    heads[bucket] = -1;
+    if (level < Levels) {occupied[level] &= ~(quint64(1) << index);}
+
+    while (key >= 0) {
+        const int following = next[key];
+        place(key);
+        key = following;
+    }
+
+}
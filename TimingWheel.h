@@ -0,0 +1,132 @@
+/**
+ * @file TimingWheel.h
+ * @brief Defines the TimingWheel class, a hierarchical timing wheel for LED off-deadlines.
+ * @details This header file contains the declaration of the TimingWheel class. Deadlines are kept in four levels of 64 buckets each, with one tick per millisecond, which covers about 4.6 hours ahead. Every key (an LED slot) can have at most one pending deadline, and the pending deadlines are kept in intrusive doubly-linked lists stored in plain arrays, so arming and cancelling are O(1) and expiry is O(1) amortized per deadline.
+ * @author Group 3
+ */
+
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+// Including necessary modules.
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @class TimingWheel
+ * @brief Hierarchical timing wheel indexed by integer keys.
+ * @details A deadline is placed at the level of the highest 6-bit digit in which it differs from the current time. When the current time reaches the start of a bucket on a higher level, that bucket is cascaded into the lower levels. The wheel does not run on its own: the owner asks for nextEventTime(), sleeps until then and calls advance().
+ * @author Group 3
+ */
+class TimingWheel {
+
+public:
+
+    /**
+     * @brief Constructor for TimingWheel.
+     * @details Creates an empty wheel whose current time is 0.
+     */
+    TimingWheel();
+
+    /**
+     * @brief Adds a key at the end of the key range.
+     * @details The new key has no pending deadline.
+     */
+    void appendKey();
+
+    /**
+     * @brief Removes every key and every pending deadline.
+     */
+    void clear();
+
+    /**
+     * @brief Reserves memory for a number of keys.
+     * @param count The number of keys to reserve space for.
+     */
+    void reserve(int count);
+
+    /**
+     * @brief Sets the deadline of a key, replacing any pending one.
+     * @details A deadline at or before the current time is due at the next call to advance().
+     * @param key The key to arm.
+     * @param deadline The deadline in ticks.
+     */
+    void arm(int key, qint64 deadline);
+
+    /**
+     * @brief Cancels the pending deadline of a key, if any.
+     * @param key The key to cancel.
+     */
+    void cancel(int key);
+
+    /**
+     * @brief Cancels every pending deadline while keeping the keys.
+     */
+    void cancelAll();
+
+    /**
+     * @brief Checks if a key has a pending deadline.
+     * @param key The key to check.
+     * @return bool True if the key is armed, false otherwise.
+     */
+    bool isArmed(int key) const;
+
+    /**
+     * @brief Gets the number of pending deadlines.
+     * @return int The number of armed keys.
+     */
+    int pendingCount() const;
+
+    /**
+     * @brief Gets the time at which the wheel next needs to advance.
+     * @details This is either the earliest pending deadline, or the earlier start of a higher-level bucket that must be cascaded first. It is never later than the earliest pending deadline.
+     * @return qint64 The time in ticks, or -1 if nothing is pending.
+     */
+    qint64 nextEventTime() const;
+
+    /**
+     * @brief Advances the current time and collects every expired key.
+     * @details Processes all cascades and expiries up to and including the given time. Expired keys are disarmed and appended to the output vector.
+     * @param now The new current time in ticks. Times earlier than the current time are ignored.
+     * @param expired Vector receiving the expired keys.
+     * @return int The number of keys that expired.
+     */
+    int advance(qint64 now, QVector<int> &expired);
+
+private:
+
+    static const int Levels = 4; // Number of wheel levels.
+    static const int BucketBits = 6; // Each level resolves one 6-bit digit of the time.
+    static const int Buckets = 1 << BucketBits; // Buckets per level.
+
+    qint64 current; // Current time in ticks.
+    int pending; // Number of armed keys.
+    QVector<qint64> deadlines; // Deadline of each key.
+    QVector<int> buckets; // Bucket holding each key (level * Buckets + index), -1 if not armed.
+    QVector<int> next; // Next key in the same bucket, -1 at the end.
+    QVector<int> prev; // Previous key in the same bucket, -1 at the head.
+    int heads[Levels * Buckets + 1]; // First key in each bucket, -1 if empty. The last bucket holds deadlines beyond the top level.
+    quint64 occupied[Levels]; // Bit i of level l is set if bucket i of level l is non-empty.
+
+    /**
+     * @brief Places an armed key into the bucket matching its deadline.
+     * @param key The key to place. Its deadline must already be stored.
+     */
+    void place(int key);
+
+    /**
+     * @brief Removes a key from its bucket without changing its deadline.
+     * @param key The key to unlink. Must be armed.
+     */
+    void unlink(int key);
+
+    /**
+     * @brief Moves every key in one higher-level bucket down to the lower levels.
+     * @param level The level of the bucket.
+     * @param index The index of the bucket within its level.
+     */
+    void cascade(int level, int index);
+
+};
+
+#endif // TIMINGWHEEL_H
@@ -0,0 +1,194 @@
+/**
+ * @file Trace.cpp
+ * @brief Implementation of the Trace class.
+ * @details This file contains the implementation of the Trace class: the registry of per-thread span buffers and the writer of the Chrome trace-event format. Every buffer has its own mutex, which only the owning thread and write() ever take, so recording a span never contends with other threads that record.
+ * @see Trace.h for the declaration of the Trace class.
+ * @author Group 3
+ */
+
+#include "include/utils/Trace.h"
+
+// Including necessary modules.
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief One finished span.
+ */
+struct Event {
+    const char *name; // Name of the span.
+    qint64 start; // Start in nanoseconds on the trace clock.
+    qint64 duration; // Duration in nanoseconds.
+};
+
+/**
+ * @brief Spans recorded by one thread.
+ */
+struct Buffer {
+    QMutex mutex; // Guards events against write() on another thread.
+    QVector<Event> events; // Spans in the order they ended.
+    int thread; // Number of the thread, used as "tid".
+    QByteArray threadName; // Name shown for the thread.
+};
+
+QMutex registryMutex; // Guards buffers and dropped.
+QVector<Buffer*> buffers; // Buffers of every thread that recorded a span, kept for the lifetime of the process.
+quint64 dropped = 0; // Spans lost because a buffer was full.
+thread_local Buffer *localBuffer = nullptr; // Buffer of the calling thread, once it recorded a span.
+
+/**
+ * @brief Gets the trace clock.
+ * @return The clock, started on first use.
+ */
+const QElapsedTimer &clock() {
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer started;
+        started.start();
+        return started;
+    }();
+    return timer;
+}
+
+/**
+ * @brief Creates and registers the calling thread's buffer.
+ * @return The new buffer.
+ */
+Buffer *registerThread() {
+    Buffer *buffer = new Buffer;
+    QThread *thread = QThread::currentThread();
+    QMutexLocker locker(&registryMutex);
+    buffer->thread = buffers.size() + 1;
+    if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {buffer->threadName = "main";}
+    else if (!thread->objectName().isEmpty()) {buffer->threadName = thread->objectName().toUtf8();}
+    else {buffer->threadName = "thread " + QByteArray::number(buffer->thread);}
+    buffers.append(buffer);
+    return buffer;
+}
+
+}
+
+QAtomicInt Trace::running(0);
+
+/**
+ * @brief Discards every recorded span and starts tracing.
+ * @details Also starts the trace clock, so that the first span does not pay for it.
+ */
+void Trace::start() {
+    clock();
+    QMutexLocker locker(&registryMutex);
+    for (Buffer *buffer : std::as_const(buffers)) {
+        QMutexLocker bufferLocker(&buffer->mutex);
+        buffer->events.clear();
+    }
+    dropped = 0;
+    running.storeRelaxed(1);
+}
+
+/**
+ * @brief Stops tracing.
+ */
+void Trace::stop() {
+    running.storeRelaxed(0);
+}
+
+/**
+ * @brief Checks if tracing runs.
+ * @return True while tracing runs.
+ */
+bool Trace::isRunning() {
+    return running.loadRelaxed() != 0;
+}
+
+/**
+ * @brief Writes the recorded spans as a Chrome trace-event file.
+ * @details Timestamps are written in microseconds, as the format requires, with nanosecond precision. Each buffer is copied under its mutex and formatted afterwards, so a thread that keeps tracing is only blocked for the copy.
+ * @param path The path of the file to write.
+ * @return True if the file was written.
+ */
+bool Trace::write(const QString &path) {
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {return false;}
+
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    QByteArray out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+
+    QMutexLocker locker(&registryMutex);
+    for (Buffer *buffer : std::as_const(buffers)) {
+
+        QVector<Event> events;
+        {
+            QMutexLocker bufferLocker(&buffer->mutex);
+            events = buffer->events;
+        }
+
+        const QByteArray tid = QByteArray::number(buffer->thread);
+        if (!first) {out += ",\n";}
+        first = false;
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid + ",\"args\":{\"name\":\"" + buffer->threadName + "\"}}";
+
+        for (const Event &event : std::as_const(events)) {
+            out += ",\n{\"name\":\"";
+            out += event.name;
+            out += "\",\"ph\":\"X\",\"ts\":" + QByteArray::number(event.start / 1e3, 'f', 3) + ",\"dur\":" + QByteArray::number(event.duration / 1e3, 'f', 3)
+                 + ",\"pid\":" + pid + ",\"tid\":" + tid + "}";
+            if (out.size() > (1 << 20)) { // Writing in chunks to bound memory.
+                file.write(out);
+                out.clear();
+            }
+        }
+
+    }
+
+    out += "\n]}\n";
+    file.write(out);
+    return file.error() == QFileDevice::NoError;
+
+}
+
+/**
+ * @brief Gets the number of spans lost because a buffer was full.
+ * @return The number of dropped spans.
+ */
+quint64 Trace::droppedCount() {
+    QMutexLocker locker(&registryMutex);
+    return dropped;
+}
+
+/**
+ * @brief Reads the trace clock.
+ * @return Nanoseconds since the clock was started.
+ */
+qint64 Trace::now() {
+    return clock().nsecsElapsed();
+}
+
+/**
+ * @brief Appends a finished span to the calling thread's buffer.
+ * @param name The name of the span.
+ * @param start The start of the span.
+ */
+void Trace::record(const char *name, qint64 start) {
+
+    const qint64 end = now();
+    if (!localBuffer) {localBuffer = registerThread();}
+
+    QMutexLocker locker(&localBuffer->mutex);
+    if (localBuffer->events.size() < EventLimit) {
+        localBuffer->events.append({name, start, end - start});
+    } else {
+        locker.unlock();
+        QMutexLocker registryLocker(&registryMutex);
+        ++dropped;
+    }
+
+}
@@ -0,0 +1,113 @@
+/**
+ * @file Trace.h
+ * @brief Defines the Trace class, which records scoped spans and exports them as Chrome trace events.
+ * @details This header file contains the declaration of the Trace class. Spans mark paints, layout passes, timer callbacks, interface slots and commands. While tracing runs, every span is appended to a buffer of the thread it ran on; on demand, all buffers are written as a Chrome trace-event JSON file that Perfetto or chrome://tracing can open.
+ * @author Group 3
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+// Including necessary modules.
+#include <QAtomicInt>
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @class Trace
+ * @brief Process-wide recorder of timed spans.
+ * @details Span names must be string literals, since only the pointer is stored. Each thread appends to its own buffer, which is created on the thread's first span and kept until the next start(), so spans of finished threads can still be written. A buffer holds at most EventLimit spans; further spans are counted as dropped.
+ * @author Group 3
+ */
+class Trace {
+
+public:
+
+    /**
+     * @class Span
+     * @brief Records the time from its construction to its destruction.
+     * @details While tracing is stopped, the constructor costs one relaxed load and one well-predicted branch, and the destructor nothing beyond checking the result of that branch.
+     * @author Group 3
+     */
+    class Span {
+
+    public:
+
+        /**
+         * @brief Starts a span if tracing runs.
+         * @param name The name of the span, a string literal.
+         */
+        explicit Span(const char *name) : name(name), start(Q_UNLIKELY(running.loadRelaxed()) ? now() : -1) {}
+
+        /**
+         * @brief Ends the span and records it, if it was started.
+         */
+        ~Span() {
+            if (start >= 0) {record(name, start);}
+        }
+
+    private:
+
+        const char *name; // Name of the span.
+        qint64 start; // Start in nanoseconds on the trace clock, or -1 if tracing was stopped.
+
+        Q_DISABLE_COPY(Span)
+
+    };
+
+    /**
+     * @brief Discards every recorded span and starts tracing.
+     */
+    static void start();
+
+    /**
+     * @brief Stops tracing.
+     * @details Recorded spans are kept until the next start(), so they can still be written.
+     */
+    static void stop();
+
+    /**
+     * @brief Checks if tracing runs.
+     * @return bool True between start() and stop().
+     */
+    static bool isRunning();
+
+    /**
+     * @brief Writes the recorded spans as a Chrome trace-event file.
+     * @details Each span becomes a complete event ("ph": "X") with its thread as "tid", and each thread gets a name. Tracing may keep running while the file is written.
+     * @param path The path of the file to write.
+     * @return bool True if the file was written.
+     */
+    static bool write(const QString &path);
+
+    /**
+     * @brief Gets the number of spans lost because a buffer was full.
+     * @return quint64 The number of dropped spans since the last start().
+     */
+    static quint64 droppedCount();
+
+    /**
+     * @brief Maximum number of spans kept per thread.
+     */
+    static const int EventLimit = 1 << 20;
+
+private:
+
+    static QAtomicInt running; // 1 while tracing runs.
+
+    /**
+     * @brief Reads the trace clock.
+     * @return qint64 Nanoseconds since the clock was started.
+     */
+    static qint64 now();
+
+    /**
+     * @brief Appends a finished span to the calling thread's buffer.
+     * @param name The name of the span.
+     * @param start The start of the span in nanoseconds on the trace clock.
+     */
+    static void record(const char *name, qint64 start);
+
+};
+
+#endif // TRACE_H
@@ -0,0 +1,74 @@
+/**
+ * @file TripleBuffer.h
+ * @brief Defines the TripleBuffer class template, a lock-free handoff of the latest value from one thread to another.
+ * @details This header file contains the declaration and implementation of the TripleBuffer class template. The effect engine renders frames on its own thread and hands them to the GUI thread through a triple buffer, so neither side ever waits for the other: the producer always has a buffer to write into and the consumer always has a complete frame to read.
+ * @author Group 3
+ */
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+// Including necessary modules.
+#include <QAtomicInt>
+
+/**
+ * @class TripleBuffer
+ * @brief Three values shared by exactly one producer and one consumer.
+ * @details At any time one buffer belongs to the producer (the back buffer), one to the consumer (the front buffer), and one is in the middle, holding the latest published value. Publishing swaps the back buffer with the middle one, and taking swaps the middle one with the front buffer, each with a single atomic exchange of the middle index. A flag stored next to the index tells the consumer whether the middle buffer is newer than its front buffer. Values the consumer never took are simply overwritten, so a slow consumer skips frames instead of slowing the producer down. Buffers are reused rather than copied, so a value that owns memory, such as a vector of the same size every frame, is not reallocated.
+ * @author Group 3
+ */
+template <typename T>
+class TripleBuffer {
+
+public:
+
+    /**
+     * @brief Gives the producer its buffer.
+     * @details Only to be called from the producer thread. The buffer holds whatever was written into it three publishes ago, not the latest value.
+     * @return T& The back buffer.
+     */
+    T &back() {
+        return buffers[backIndex];
+    }
+
+    /**
+     * @brief Makes the back buffer the latest value.
+     * @details Only to be called from the producer thread. The release ordering makes everything written into the buffer visible to the consumer that takes it.
+     */
+    void publish() {
+        backIndex = middle.fetchAndStoreAcqRel(backIndex | Fresh) & IndexMask;
+    }
+
+    /**
+     * @brief Moves the latest value to the front buffer.
+     * @details Only to be called from the consumer thread. Does nothing if nothing was published since the last call.
+     * @return bool True if the front buffer now holds a newer value.
+     */
+    bool take() {
+        if (!(middle.loadAcquire() & Fresh)) {return false;}
+        frontIndex = middle.fetchAndStoreAcqRel(frontIndex) & IndexMask;
+        return true;
+    }
+
+    /**
+     * @brief Gives the consumer its buffer.
+     * @details Only to be called from the consumer thread. The buffer stays unchanged until the next take().
+     * @return const T& The front buffer.
+     */
+    const T &front() const {
+        return buffers[frontIndex];
+    }
+
+private:
+
+    static const int IndexMask = 3; // Bits of the middle state holding the index.
+    static const int Fresh = 4; // Bit of the middle state set while the middle buffer was not taken yet.
+
+    T buffers[3]; // The three values.
+    int backIndex = 0; // Buffer owned by the producer.
+    int frontIndex = 1; // Buffer owned by the consumer.
+    QAtomicInt middle{2}; // Index of the buffer in the middle, with the Fresh bit.
+
+};
+
+#endif // TRIPLEBUFFER_H
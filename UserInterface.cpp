@@ -7,16 +7,18 @@
  */
 
 #include "include/interfaces/UserInterface.h"
+#include "include/models/Effects.h"
+#include "include/utils/EventLog.h"
+#include "include/utils/Trace.h"
 
 // Including necessary modules.
-#include <QDebug>
 #include <QColorDialog>
 #include <QMessageBox>
-#include <QLabel>
 #include <QFont>
+#include <QPalette>
 #include <QStyle>
 #include <QInputDialog>
-#include <algorithm>
+#include <QShortcut>
 
 /**
  * @class UserInterface
@@ -27,13 +29,18 @@
 
 /**
  * @brief Constructs a UserInterface object.
- * @details Initializes the user interface, setting up the main window, configuring the layout, and preparing all interactive elements like buttons and displays for the LEDs. It also initializes the LED ID counter used for assigning unique IDs to LEDs.
+ * @details Initializes the user interface, setting up the main window, configuring the layout, and preparing all interactive elements like buttons and displays for the LEDs.
  * @param parent Pointer to the parent widget, which defaults to nullptr.
  */
-UserInterface::UserInterface(QWidget *parent) : QWidget(parent), nextLedId(1) {
+UserInterface::UserInterface(QWidget *parent) : QWidget(parent), controller(new LedController(this)), store(controller->ledStore()), output(controller->outputFrame()) {
 
     setWindowTitle("Pilluminate (Group 3)"); // Setting the window title.
 
+    // Font setup; set as a font rather than a style sheet, so that it is inherited without styling every child through QStyleSheetStyle.
+    QFont windowFont("Arial");
+    windowFont.setPixelSize(14);
+    setFont(windowFont);
+
     // Main layout setup.
     mainLayout = new QVBoxLayout(this);
     mainLayout->setAlignment(Qt::AlignTop);
@@ -45,28 +52,51 @@ UserInterface::UserInterface(QWidget *parent) : QWidget(parent), nextLedId(1) {
     titleFont.setBold(true);
     titleLabel->setFont(titleFont);
     titleLabel->setAlignment(Qt::AlignCenter);
-    titleLabel->setStyleSheet("color: #2E8B57;");  
+    QPalette titlePalette = titleLabel->palette();
+    titlePalette.setColor(QPalette::WindowText, QColor(0x2E, 0x8B, 0x57));
+    titleLabel->setPalette(titlePalette);
     mainLayout->addWidget(titleLabel);
 
     createControlPanel(); // Control panel setup.
 
-    // LEDs container setup.
-    QWidget *container = new QWidget();
-    container->setStyleSheet("background-color: gray;");  
-    ledsGrid = new QGridLayout(container);
-    container->setLayout(ledsGrid);
-    ledsContainer = new QScrollArea(this);
-    ledsContainer->setWidget(container);
-    ledsContainer->setWidgetResizable(true);
-    ledsContainer->setFrameShape(QFrame::NoFrame);
-    mainLayout->addWidget(ledsContainer);
-    setLayout(mainLayout);
+    // LED view setup; the view scrolls itself and only paints what is inside its viewport.
+    ledView = new LedMatrixView(store, output, this);
+    connect(ledView, &LedMatrixView::removeRequested, this, &UserInterface::removeLED);
+    connect(ledView, &LedMatrixView::toggleRequested, this, &UserInterface::toggleLED);
+    connect(ledView, &LedMatrixView::colorChangeRequested, this, &UserInterface::changeLEDColor);
+    connect(ledView, &LedMatrixView::blinkSpeedChangeRequested, this, &UserInterface::setLEDBlinkSpeed);
+    connect(ledView, &LedMatrixView::durationChangeRequested, this, &UserInterface::setLEDDuration);
+    ledView->setFrameShape(QFrame::NoFrame);
+    mainLayout->addWidget(ledView);
+
+    // Blink ticks, expired durations and effect frames; one repaint per batch, covering only the LEDs that changed.
+    connect(controller, &LedController::ledsChanged, this, &UserInterface::scheduleRepaint);
+
+    // Statistics label setup.
+    statsLabel = new QLabel(this);
+    mainLayout->addWidget(statsLabel);
+    statsTimer = new QTimer(this);
+    connect(statsTimer, &QTimer::timeout, this, &UserInterface::updateStats);
+    statsTimer->start(1000);
+    statsLabel->setText("LEDs: 0 | On: 0 | Blinking: 0 | Timed: 0 | Timer wakeups per second: 0");
+
+    // Dithering timer setup; started once dithering is enabled with a correction that changes colors.
+    ditherTimer = new QTimer(this);
+    ditherTimer->setInterval(EffectEngine::FrameInterval);
+    connect(ditherTimer, &QTimer::timeout, this, &UserInterface::ditherFrame);
+
+    // Tracing shortcut setup.
+    QShortcut *traceShortcut = new QShortcut(QKeySequence(Qt::Key_F4), this);
+    connect(traceShortcut, &QShortcut::activated, this, &UserInterface::toggleTrace);
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+    // Performance overlay setup; hidden until toggled with F3.
+    perfOverlay = new PerfOverlay(ledView, store, this);
+    QShortcut *overlayShortcut = new QShortcut(QKeySequence(Qt::Key_F3), this);
+    connect(overlayShortcut, &QShortcut::activated, this, &UserInterface::togglePerfOverlay);
+#endif
 
-    // Style setup for the application.
-    this->setStyleSheet("QPushButton { background-color: #2E8B57; color: white; border-radius: 5px; padding: 6px; margin: 6px; }"
-                        "QPushButton:hover { background-color: #3CB371; }"
-                        "QScrollArea { border: none; }"
-                        "QWidget { font-family: 'Arial'; font-size: 14px; }");
+    setLayout(mainLayout);
 
 }
 
@@ -78,135 +108,217 @@ UserInterface::~UserInterface() {}
 
 /**
  * @brief Adds a new LED to the interface.
- * @details Creates a new VirtualLED instance, assigns it a unique ID, and adds it to the UI. It also sets up necessary signal-slot connections for the LED to interact with the rest of the interface.
+ * @details Adds a single LED through the bulk path, which places only the new cell in the grid.
  */
 void UserInterface::addNewLED() {
+    Trace::Span span("UserInterface::addNewLED");
+    if (!addLEDs(1)) {QMessageBox::warning(this, "Operation Failed", "<b>No more LEDs can be added.</b>");}
+}
+
+/**
+ * @brief Adds a number of LEDs at once.
+ * @details The controller takes the slots from the LED store, reusing slots freed by earlier removals first, and checks the capacity. No VirtualLED objects are created here; findLEDById() creates them when an LED is first operated on individually, so adding LEDs only touches the store's arrays and the output frame.
+ * @param count The number of LEDs to add.
+ * @return True if the LEDs were added.
+ */
+bool UserInterface::addLEDs(int count) {
 
-    VirtualLED *newLed = new VirtualLED(nextLedId, this); // Creating a new LED with the next available ID.
+    Trace::Span span("UserInterface::addLEDs");
 
-    // Setting up signal connections for the new LED.
-    connect(newLed, &VirtualLED::removed, this, &UserInterface::removeLED);
-    connect(newLed, &VirtualLED::colorChanged, this, &UserInterface::changeLEDColor);
+    const int before = store.size();
+    if (controller->addLeds(count) == LedController::Full) {return false;}
 
-    // Adding the new LED to the list and updating the grid layout.
-    leds.append(newLed); 
-    updateGridLayout(); 
-    qDebug() << "LED #" << nextLedId << "added."; 
-    nextLedId++; 
+    leds.resize(store.slotCount()); // New slots start without a VirtualLED.
+    output.update(); // Correcting the new LEDs, and reused slots that still hold a removed LED's color, before they are drawn.
+    ledView->ledsAppended(store.size() - before); // One layout pass and one repaint for the whole batch.
+    return true;
 
 }
 
 /**
- * @brief Turns all LEDs on.
- * @details Iterates over all available LEDs, turning them on by changing their color to white. If no LEDs are available or all are already on, it displays a warning message.
+ * @brief Removes a range of LEDs at once.
+ * @details The slots are copied out of the display order first, since removing LEDs may compact it.
+ * @param first The display position of the first LED to remove.
+ * @param count The number of LEDs to remove.
  */
-void UserInterface::turnAllLEDsOn() {
+void UserInterface::removeLEDs(int first, int count) {
+    Trace::Span span("UserInterface::removeLEDs");
+    const QVector<int> &order = store.displayOrder();
+    const int begin = qMax(0, first);
+    const int end = qMin(order.size(), first + count);
+    if (begin < end) {removeSlots(order.mid(begin, end - begin));}
+}
 
-    // Check if there are no LEDs to turn on.
-    if (leds.isEmpty()) {
-        QMessageBox::warning(this, "Operation Failed", "<b>No LEDs available to turn on.</b>"); 
-        qDebug() << "No LEDs available to turn on."; 
-        return; 
+/**
+ * @brief Removes every LED matching a predicate at once.
+ * @details The predicate is evaluated for every live slot before anything is removed.
+ * @param predicate Function called with the slot of each LED, returning true for LEDs to remove.
+ */
+void UserInterface::removeLEDs(const std::function<bool(int)> &predicate) {
+    QVector<int> targets;
+    const BitSet &live = store.liveBits();
+    for (int i = live.nextSet(0); i >= 0; i = live.nextSet(i + 1)) {if (predicate(i)) {targets.append(i);}}
+    removeSlots(targets);
+}
+
+/**
+ * @brief Removes the LEDs in a set of slots.
+ * @details Each removal is O(1) in the store; the grid is refreshed once at the end since the remaining LEDs may shift arbitrarily.
+ * @param targets The slots of the LEDs to remove.
+ */
+void UserInterface::removeSlots(const QVector<int> &targets) {
+
+    if (targets.isEmpty()) {return;}
+
+    for (int slot : targets) {
+        delete leds.at(slot); // Deleting the LED object, if one was created.
+        leds[slot] = nullptr;
     }
+    controller->removeSlots(targets);
+    updateGridLayout(); // One layout pass and one repaint for the whole batch.
 
-    bool allLedsAlreadyOn = std::all_of(leds.begin(), leds.end(), [](VirtualLED* led){ return led->isOn(); }); // Determine if all LEDs are already on.
+}
 
-    // Handling case where all LEDs are already on.
-    if (allLedsAlreadyOn) {
-        QMessageBox::warning(this, "Operation Failed", "<b>All LEDs are already turned on.</b>"); 
-        qDebug() << "All LEDs were already on."; 
-    } else {
-        // Turning all LEDs on.
-        for (VirtualLED* led : leds) {
-            if (!led->isOn()) {led->setColor(Qt::white);}
-            led->stopOffTimer(); // Explicitly stop the offTimer to prevent it from turning off the LED.
-        } 
-        qDebug() << "All LEDs turned on."; 
+/**
+ * @brief Deletes the VirtualLED objects of slots that are no longer live.
+ * @details Only slots that had a VirtualLED are looked at in the store.
+ */
+void UserInterface::dropRemovedLEDs() {
+    const BitSet &live = store.liveBits();
+    for (int i = 0; i < leds.size(); ++i) {
+        if (leds.at(i) && !live.test(i)) {
+            delete leds.at(i);
+            leds[i] = nullptr;
+        }
+    }
+}
+
+/**
+ * @brief Adds a user-chosen number of LEDs.
+ * @details Opens a dialog for the number of LEDs, limited by the capacity of the store, and adds them in one bulk operation.
+ */
+void UserInterface::addMultipleLEDs() {
+
+    Trace::Span span("UserInterface::addMultipleLEDs");
+
+    const int available = LedStore::MaxSlots - store.size();
+    if (available <= 0) {
+        QMessageBox::warning(this, "Operation Failed", "<b>No more LEDs can be added.</b>");
+        EventLog::record(EventLog::CapacityReached);
+        return;
     }
 
+    bool ok;
+    int count = QInputDialog::getInt(this, "Add Multiple LEDs", "Number of LEDs:", qMin(1000, available), 1, available, 1, &ok); // Open dialog to select the number of LEDs.
+    if (ok) {addLEDs(count);}
+
 }
 
 /**
- * @brief Turns all LEDs off.
- * @details Checks each LED in the interface and turns it off if it is currently on. Displays a warning if no LEDs are available to turn off.
+ * @brief Removes every LED that is off.
+ * @details Has the controller remove all of them in one bulk operation. Displays a warning if there is nothing to remove.
  */
-void UserInterface::turnAllLEDsOff() {
+void UserInterface::removeOffLEDs() {
 
-    // Check if there are no LEDs to turn off.
-    if (leds.isEmpty()) {
-        QMessageBox::warning(this, "Operation Failed", "<b>No LEDs available to turn off.</b>");
-        qDebug() << "No LEDs available to turn off.";
+    Trace::Span span("UserInterface::removeOffLEDs");
+
+    switch (controller->removeOff()) {
+    case LedController::NoLeds:
+        QMessageBox::warning(this, "Operation Failed", "<b>No LEDs available to remove.</b>");
         return;
+    case LedController::NoneOff:
+        QMessageBox::warning(this, "Operation Failed", "<b>No LEDs are off.</b>");
+        return;
+    default:
+        dropRemovedLEDs();
+        updateGridLayout(); // One layout pass and one repaint for the whole batch.
     }
 
-    bool allAlreadyOff = true; // Flag to check if all LEDs were already off.
+}
 
-    // Turning off each LED if it's on.
-    for (VirtualLED *led : leds) {
-        if (led->isOn()) {
-            led->turnOff(); 
-            allAlreadyOff = false;
-        }
+/**
+ * @brief Turns all LEDs on.
+ * @details The controller changes the color of every LED that is off to white, sets the on/off flags of all LEDs at once and cancels any pending duration. The view is repainted once afterwards. If no LEDs are available or all are already on, it displays a warning message.
+ */
+void UserInterface::turnAllLEDsOn() {
+
+    Trace::Span span("UserInterface::turnAllLEDsOn");
+
+    switch (controller->turnAll(true)) {
+    case LedController::NoLeds:
+        QMessageBox::warning(this, "Operation Failed", "<b>No LEDs available to turn on.</b>");
+        break;
+    case LedController::AllOn:
+        QMessageBox::warning(this, "Operation Failed", "<b>All LEDs are already turned on.</b>");
+        break;
+    default:
+        scheduleRepaint();
     }
 
-    // Handling case where all LEDs were already off.
-    if (allAlreadyOff) {
+}
+
+/**
+ * @brief Turns all LEDs off.
+ * @details The controller clears the color, blink period and blink phase of every LED that is on, clears the on/off flags of all LEDs at once and cancels every pending duration, so that the timed count drops to zero and the duration scheduler stops waking. The view is repainted once afterwards. Displays a warning if no LEDs are available to turn off.
+ */
+void UserInterface::turnAllLEDsOff() {
+
+    Trace::Span span("UserInterface::turnAllLEDsOff");
+
+    switch (controller->turnAll(false)) {
+    case LedController::NoLeds:
+        QMessageBox::warning(this, "Operation Failed", "<b>No LEDs available to turn off.</b>");
+        break;
+    case LedController::AllOff:
         QMessageBox::warning(this, "Operation Ineffective", "<b>All LEDs are already off.</b>");
-        qDebug() << "All LEDs were already off.";
-    } else {qDebug() << "All LEDs turned off.";}
+        break;
+    default:
+        scheduleRepaint();
+    }
 
 }
 
 /**
  * @brief Removes all LEDs from the interface.
- * @details Deletes all VirtualLED instances from the interface, clears the internal list maintaining the LEDs, and resets the ID counter.
+ * @details Deletes all VirtualLED instances from the interface, clears the internal list maintaining the LEDs, and has the controller empty the store. Handles of the removed LEDs become stale.
  */
 void UserInterface::removeAllLEDs() {
 
+    Trace::Span span("UserInterface::removeAllLEDs");
+
     // Check if there are LEDs to remove.
-    if (leds.isEmpty()) {
+    if (controller->removeAll() == LedController::NoLeds) {
         QMessageBox::warning(this, "Operation Failed", "<b>No LEDs available to remove.</b>"); 
-        qDebug() << "No LEDs available to remove.";
         return;
     }
 
     // Deleting all LED objects and clearing the list.
     qDeleteAll(leds); 
     leds.clear(); 
-    nextLedId = 1; // Resetting the ID counter.
     updateGridLayout(); // Updating the grid layout.
-    qDebug() << "All LEDs have been removed.";
 
 }
 
 /**
  * @brief Removes a specific LED by its ID.
- * @details Locates an LED by its unique ID and removes it from the interface. This involves deleting the VirtualLED instance and updating the layout accordingly.
+ * @details Locates an LED by its unique ID and removes it from the interface. This involves having the controller free its slot in the store, deleting the VirtualLED instance and updating the layout accordingly. The remaining LEDs keep their IDs, so removal is O(1); only the display numbers shift, and those are computed when next needed.
  * @param id The ID of the LED to remove.
  */
 void UserInterface::removeLED(int id) {
 
-    VirtualLED* ledToRemove = findLEDById(id); // Finding the LED by ID.
+    Trace::Span span("UserInterface::removeLED");
 
-    if (ledToRemove) {
-        leds.removeOne(ledToRemove); // Removing the LED from the list.
-        ledsGrid->removeWidget(ledToRemove); // Removing the LED widget from the grid layout.
-        ledToRemove->deleteLater(); // Deleting the LED object.
-        reassignLEDIds(); // Reassigning IDs to the remaining LEDs.
-        updateGridLayout(); // Updating the grid layout.
-        qDebug() << "LED #" << id << "removed."; 
-    }
+    int slot = store.slotOf(id); // Finding the LED's slot by ID; stale IDs are ignored.
 
-}
+    if (slot >= 0) {
+        int index = store.displayIndex(slot); // Display position, taken before the LED is gone.
+        delete leds.at(slot); // Deleting the LED object.
+        leds[slot] = nullptr; // Leaving the slot empty until the store reuses it.
+        controller->remove(slot); // Freeing the LED's slot in the store.
+        output.update(); // Dropping the removed LED's corrected color along with it.
+        ledView->ledRemoved(index); // Shifting only the cells after the removed one.
+    }
 
-/**
- * @brief Reassigns IDs to all LEDs, starting from 1.
- * @details Iterates over all LEDs, assigning them new consecutive IDs starting from 1. This is typically called after an LED has been removed to ensure continuous ID sequencing.
- */
-void UserInterface::reassignLEDIds() {
-    int id = 1; // Starting ID.
-    for (VirtualLED* led : leds) {led->setId(id++);} // Assigning new ID to each LED.
-    nextLedId = id; // Setting the next LED ID to the next available number.
 }
 
 /**
@@ -216,104 +328,157 @@ void UserInterface::reassignLEDIds() {
  * @param color The new color for the LED.
  */
 void UserInterface::changeLEDColor(int id, const QColor &color) {
+    Trace::Span span("UserInterface::changeLEDColor");
     
     VirtualLED *led = findLEDById(id); // Finding the LED by ID.
 
+    if (led) {led->setColor(color);} // Setting the new color for the identified LED.
+
+}
+
+/**
+ * @brief Toggles a specific LED on or off.
+ * @details Finds an LED by its ID and turns it off if it is on, or on if it is off. Triggered by a left click on the LED.
+ * @param id The ID of the LED to toggle.
+ */
+void UserInterface::toggleLED(int id) {
+
+    Trace::Span span("UserInterface::toggleLED");
+
+    VirtualLED *led = findLEDById(id); // Finding the LED by ID.
+
     if (led) {
-        led->setColor(color); // Setting the new color for the identified LED.
-        qDebug() << "LED #" << id << "color changed to" << color.name() << "."; 
+        if (led->isOn()) {led->turnOff();} // If the LED is on, turn it off.
+        else {led->turnOn();} // If the LED is off, turn it on.
     }
 
 }
 
+/**
+ * @brief Sets the blinking speed of a specific LED.
+ * @details Finds an LED by its ID and applies the blinking speed chosen in its context menu.
+ * @param id The ID of the LED.
+ * @param speed The blinking speed in milliseconds.
+ */
+void UserInterface::setLEDBlinkSpeed(int id, int speed) {
+
+    Trace::Span span("UserInterface::setLEDBlinkSpeed");
+
+    VirtualLED *led = findLEDById(id); // Finding the LED by ID.
+
+    if (led) {led->setBlinkSpeed(speed);}
+
+}
+
+/**
+ * @brief Sets how long a specific LED stays on.
+ * @details Finds an LED by its ID and applies the duration chosen in its context menu.
+ * @param id The ID of the LED.
+ * @param seconds The duration in seconds.
+ */
+void UserInterface::setLEDDuration(int id, int seconds) {
+
+    Trace::Span span("UserInterface::setLEDDuration");
+
+    VirtualLED *led = findLEDById(id); // Finding the LED by ID.
+
+    if (led) {led->setDuration(seconds);}
+
+}
+
 /**
  * @brief Changes the color of all LEDs that are currently on.
- * @details Opens a color dialog for the user to select a color, which is then applied to all currently on LEDs. If no LEDs are on, it shows a warning message.
+ * @details Opens a color dialog for the user to select a color, which is then written to the color array for all currently on LEDs and the view is repainted once. If no LEDs are on, it shows a warning message.
  */
 void UserInterface::changeAllLEDsColor() {
 
-    // Check if there are any LEDs to change color.
-    if (leds.isEmpty()) {
+    Trace::Span span("UserInterface::changeAllLEDsColor");
+
+    switch (controller->checkOnLeds(LedController::ColorChange)) { // Ensure at least one LED is on before proceeding.
+    case LedController::NoLeds:
         QMessageBox::warning(this, "Operation Failed", "<b>No LEDs available to change color.</b>");
-        qDebug() << "No LEDs available to change color.";
         return;
-    }
-
-    bool isAnyLedOn = std::any_of(leds.begin(), leds.end(), [](VirtualLED* led){ return led->isOn(); }); // Ensure at least one LED is on before proceeding.
-
-    if (!isAnyLedOn) {
+    case LedController::NoneOn:
         QMessageBox::warning(this, "Operation Failed", "<b>At least one LED must be on to change colors.</b>");
-        qDebug() << "No LEDs are on, can't change colors.";
         return;
+    default:
+        break;
     }
 
     QColor color = QColorDialog::getColor(Qt::white, this, "Select Color For All LEDs"); // Open color selection dialog.
-
-    if (color.isValid()) {
-        for (VirtualLED* led : leds) {if (led->isOn()) {led->setColor(color);}} // Apply the selected color to all LEDs that are on.
-        qDebug() << "Changed color of all on LEDs to" << color.name() << ".";
-    }
+    if (color.isValid()) {setOnLEDsColor(color);}
     
 }
 
+/**
+ * @brief Changes the color of every LED that is on.
+ * @details The controller writes the colors and logs them as one batch.
+ * @param color The new color.
+ */
+void UserInterface::setOnLEDsColor(const QColor &color) {
+    Trace::Span span("UserInterface::setOnLEDsColor");
+    controller->setOnColor(color);
+    scheduleRepaint();
+}
+
 /**
  * @brief Sets the blinking speed for all LEDs that are currently on.
- * @details Presents a dialog for the user to select a blinking speed, which is then applied to all LEDs that are currently on. This allows for a uniform blinking pattern across all active LEDs. If no LEDs are on or blinking, a warning message is shown to the user.
+ * @details Presents a dialog for the user to select a blinking speed, which is then written to the period array for all LEDs that are currently on. This allows for a uniform blinking pattern across all active LEDs. If no LEDs are on or blinking, a warning message is shown to the user.
  */
 void UserInterface::setAllLEDsBlinkSpeed() {
 
-    // Check if there are any LEDs to set the blinking speed.
-    if (leds.isEmpty()) {
+    Trace::Span span("UserInterface::setAllLEDsBlinkSpeed");
+
+    switch (controller->checkOnLeds(LedController::BlinkSpeedChange)) { // Ensure at least one LED is on before proceeding; blinking LEDs are on as well.
+    case LedController::NoLeds:
         QMessageBox::warning(this, "Operation Failed", "<b>No LEDs available to set blinking speed.</b>");
-        qDebug() << "No LEDs available to set blinking speed.";
         return;
-    }
-
-    bool isAnyLEDBlinkingOrOn = std::any_of(leds.begin(), leds.end(), [](VirtualLED* led){ return led->isOn() || led->getBlinkSpeed() > 0; }); // Ensure at least one LED is on or blinking before proceeding.
-
-    if (!isAnyLEDBlinkingOrOn) {
+    case LedController::NoneOn:
         QMessageBox::warning(this, "Operation Failed", "<b>At least one LED must be on to set blinking speed.</b>");
-        qDebug() << "No LEDs are on, can't set blinking speed.";
         return;
+    default:
+        break;
     }
 
     bool ok;
     int speed = QInputDialog::getInt(this, "Set All Blinking Speed", "Speed (ms):", 0, 0, 10000, 1, &ok); // Open dialog to select blinking speed.
+    if (ok) {setOnLEDsBlinkSpeed(speed);}
 
-    if (ok) {
-        for (VirtualLED* led : leds) {if (led->isOn()) {led->setBlinkSpeed(speed);}} // Apply the selected speed to all LEDs that are on.
-        qDebug() << "Blinking speed set for all on LEDs to" << speed << "ms.";
-    }
+}
 
+/**
+ * @brief Sets the blinking speed of every LED that is on.
+ * @details The controller writes the periods, logs them as one batch and wakes the blink scheduler.
+ * @param speed The blinking speed in milliseconds.
+ */
+void UserInterface::setOnLEDsBlinkSpeed(int speed) {
+    Trace::Span span("UserInterface::setOnLEDsBlinkSpeed");
+    controller->setOnBlinkSpeed(speed);
+    scheduleRepaint();
 }
 
 /**
  * @brief Sets a duration for all LEDs that are currently on.
- * @details Opens a dialog for the user to input a duration in seconds. This duration is then applied to all LEDs that are currently on, allowing them to turn off automatically after the specified time. If no LEDs are on, a warning message is shown.
+ * @details Opens a dialog for the user to input a duration in seconds. The controller then applies this duration to all LEDs that are currently on, allowing them to turn off automatically after the specified time. If no LEDs are on, a warning message is shown.
  */
 void UserInterface::setDurationForOnLEDs() {
 
-    // Check if there are any LEDs to set the duration.
-    if(leds.isEmpty()) {
+    Trace::Span span("UserInterface::setDurationForOnLEDs");
+
+    switch (controller->checkOnLeds(LedController::DurationChange)) { // Ensure at least one LED is on before proceeding.
+    case LedController::NoLeds:
         QMessageBox::warning(this, "Operation Failed", "<b>No LEDs available to set duration.</b>");
-        qDebug() << "No LEDs available to set duration.";
         return;
-    }
-
-    // Ensure at least one LED is on before proceeding.
-    if (!std::any_of(leds.begin(), leds.end(), [](VirtualLED* led){ return led->isOn(); })) {
+    case LedController::NoneOn:
         QMessageBox::warning(this, "Operation Failed", "<b>At least one LED must be on to set duration.</b>");
-        qDebug() << "No LEDs are on, can't set duration.";
         return;
+    default:
+        break;
     }
 
     bool ok;
     int duration = QInputDialog::getInt(this, "Set LEDs Duration", "Duration (seconds):", 0, 0, 3600, 1, &ok); // Open dialog to select duration.
-
-    if(ok) {
-        for(VirtualLED* led : leds) {if(led->isOn()) {led->setDuration(duration);}} // Apply the selected duration to all LEDs that are on.
-        qDebug() << "Duration set for all on LEDs to" << duration << "seconds.";
-    }
+    if(ok) {controller->setOnDuration(duration);}
 
 }
 
@@ -323,18 +488,24 @@ void UserInterface::setDurationForOnLEDs() {
  */
 void UserInterface::showHelpDialog() {
 
+    Trace::Span span("UserInterface::showHelpDialog");
+
     QMessageBox helpBox;
     helpBox.setWindowTitle("Help");
 
     // Constructing the help dialog content.
     QString helpText = "<h2>Pilluminate (Group 3) - LED Controller</h2>"
                        "<p><b>Add LED:</b> Adds a new LED to the display<br>"
+                       "<b>Add Multiple LEDs:</b> Adds a chosen number of LEDs to the display at once<br>"
                        "<b>Turn All LEDs On:</b> Turns all the LEDs on<br>"
                        "<b>Turn All LEDs Off:</b> Turns all the LEDs off<br>"
+                       "<b>Remove Off LEDs:</b> Removes all the LEDs that are off from the display<br>"
                        "<b>Remove All LEDs:</b> Removes all the LEDs from the display<br>"
                        "<b>Change All Colors:</b> Changes the color of all on LEDs present on the display<br>"
                        "<b>Set All Blink Speed:</b> Changes the blinking speed of all on LEDs present on the display<br>"
-                       "<b>Set All Duration:</b> Changes the duration of all on LEDs present on the display<br><br>"
+                       "<b>Set All Duration:</b> Changes the duration of all on LEDs present on the display<br>"
+                       "<b>Effects:</b> Runs an animation (chase, wave, breathe, rainbow, twinkle, fire or gradient) over all on LEDs, or stops it<br>"
+                       "<b>Color Correction:</b> Sets the gamma, brightness, white balance and temporal dithering applied to the colors of all LEDs as they are shown<br><br>"
                        "To remove (can be on/off), change color (must be on), set blinking speed (must be on), or set duration (must be on) for an LED individually, right-click on it</p>"
                        "<h3>Team Members:</h3>"
                        "<ul>"
@@ -344,85 +515,260 @@ void UserInterface::showHelpDialog() {
                        "<li>Deep Ashishkumar Shah</li>"
                        "<li>Alyssa Taylor Tran</li>"
                        "</ul>"; 
+    helpText += "<p><b>F4:</b> Starts tracing, or stops it and writes the trace to pilluminate-trace.json</p>";
+#ifdef PILLUMINATE_PERF_OVERLAY
+    helpText += "<p><b>F3:</b> Shows or hides the performance overlay</p>";
+#endif
 
     QMessageBox::information(this, "Help", helpText); // Displaying the help dialog.
-    qDebug() << "Help button clicked."; 
+    EventLog::record(EventLog::HelpOpened);
+
+}
 
+/**
+ * @brief Asks for the LEDs that changed to be repainted.
+ * @details The repaint is queued, so every change made before control returns to the event loop, whether by a bulk operation, single LEDs or a blink tick, is merged into one pass over the dirty flags.
+ */
+void UserInterface::scheduleRepaint() {
+    if (repaintPending) {return;}
+    repaintPending = true;
+    QMetaObject::invokeMethod(this, &UserInterface::repaintDirty, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Repaints the LEDs that changed since the last repaint.
+ * @details The output frame corrects the colors of the dirty LEDs and the view turns the dirty flags into update rectangles, after which the flags are cleared for the next frame.
+ */
+void UserInterface::repaintDirty() {
+    Trace::Span span("UserInterface::repaintDirty");
+    repaintPending = false;
+    output.update();
+    ledView->updateDirty();
+    controller->clearDirty();
 }
 
+/**
+ * @brief Starts or stops an effect.
+ * @details Lists the effects with "None" first, then asks for the colors the chosen effect uses and hands the effect to the controller. Cancelling any dialog leaves the running effect alone. The period and the number of LEDs per cycle keep their defaults.
+ */
+void UserInterface::chooseEffect() {
+
+    Trace::Span span("UserInterface::chooseEffect");
+
+    const QSharedPointer<const Effect> running = controller->effect();
+    QStringList choices = Effects::names();
+    choices.prepend("None");
+    bool ok;
+    const QString name = QInputDialog::getItem(this, "Effects", "Effect:", choices, running ? int(choices.indexOf(running->name())) : 0, false, &ok);
+    if (!ok) {return;}
+
+    if (name == "None") {
+        controller->setEffect(nullptr);
+        return;
+    }
+
+    Effects::Parameters parameters;
+    if (name != "rainbow" && name != "fire") { // The only effects with colors of their own.
+        const QColor color = QColorDialog::getColor(Qt::white, this, "Select Effect Color");
+        if (!color.isValid()) {return;}
+        parameters.color = color.rgb();
+    }
+    if (name == "gradient") {
+        const QColor color = QColorDialog::getColor(Qt::blue, this, "Select Second Gradient Color");
+        if (!color.isValid()) {return;}
+        parameters.secondColor = color.rgb();
+    }
+
+    controller->setEffect(Effects::create(name, parameters));
+
+}
+
+/**
+ * @brief Changes the color correction.
+ * @details The dialogs start from the current parameters. The white balance is picked as the color that white LEDs should show, each of its channels becoming the factor of that channel. Cancelling any dialog leaves the correction alone. The picked colors stay in the store, so the correction can be changed or undone without losing them. The dithering timer only runs while dithering can change a color.
+ */
+void UserInterface::adjustColorCorrection() {
+
+    Trace::Span span("UserInterface::adjustColorCorrection");
+
+    ColorCorrection::Parameters parameters = output.correction().parameters();
+    bool ok;
+    parameters.gamma = QInputDialog::getDouble(this, "Color Correction", "Gamma (1 leaves colors unchanged):", parameters.gamma, 0.1, 5.0, 2, &ok);
+    if (!ok) {return;}
+    parameters.brightness = QInputDialog::getInt(this, "Color Correction", "Brightness (%):", qRound(parameters.brightness * 100), 0, 100, 1, &ok) / 100.0;
+    if (!ok) {return;}
+    const QColor white = QColorDialog::getColor(QColor::fromRgbF(parameters.red, parameters.green, parameters.blue), this, "Select White Balance");
+    if (!white.isValid()) {return;}
+    parameters.red = white.redF();
+    parameters.green = white.greenF();
+    parameters.blue = white.blueF();
+    const QMessageBox::StandardButton dithering = QMessageBox::question(this, "Color Correction", "Use temporal dithering, which shows dim colors more smoothly by alternating between neighbouring levels?",
+                                                                        QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel, output.isDithering() ? QMessageBox::Yes : QMessageBox::No);
+    if (dithering == QMessageBox::Cancel) {return;}
+
+    const bool correctionChanged = output.setCorrection(parameters);
+    const bool ditheringChanged = output.setDithering(dithering == QMessageBox::Yes);
+    if (correctionChanged || ditheringChanged) {
+        output.update();
+        ledView->viewport()->update(); // Every LED may look different.
+    }
+    if (output.isDitheringActive()) {ditherTimer->start();}
+    else {ditherTimer->stop();}
+
+}
+
+/**
+ * @brief Shows the next frame of the temporal dithering.
+ * @details The whole viewport is repainted, as any LED whose color falls between two levels steps between them from frame to frame. The frame is not brought in line with the store here: every change to the store queues repaintDirty(), which updates the frame, so LEDs changed since then are dithered from their previous color for at most this one frame.
+ */
+void UserInterface::ditherFrame() {
+    Trace::Span span("UserInterface::ditherFrame");
+    output.dither();
+    ledView->viewport()->update();
+}
+
+/**
+ * @brief Refreshes the statistics shown below the LEDs.
+ * @details Computes the number of timer wakeups recorded since the previous refresh, which is called once per second, and shows it in the statistics label together with the LED counts. The store keeps the counts up to date on every change, so reading them costs nothing however many LEDs there are.
+ */
+void UserInterface::updateStats() {
+    Trace::Span span("UserInterface::updateStats");
+    BlinkScheduler::countWakeup(); // This refresh is a wakeup as well.
+    quint64 wakeups = BlinkScheduler::wakeupCount();
+    wakeupsPerSecond = wakeups - lastWakeupCount;
+    lastWakeupCount = wakeups;
+    showStats();
+}
+
+/**
+ * @brief Shows the statistics and the tracing status in the statistics label.
+ */
+void UserInterface::showStats() {
+    QString text = QString("LEDs: %1 | On: %2 | Blinking: %3 | Timed: %4 | Timer wakeups per second: %5")
+                   .arg(store.size()).arg(store.onCount()).arg(store.blinkingCount()).arg(store.timedCount()).arg(wakeupsPerSecond);
+    if (!traceStatus.isEmpty()) {text += " | " + traceStatus;}
+    statsLabel->setText(text);
+}
+
+/**
+ * @brief Starts or stops tracing.
+ * @details The trace is written once tracing has stopped, so the write itself does not show up in it. The file opens in Perfetto or chrome://tracing. The outcome stays in the statistics label until tracing is toggled again, so that it is visible without a terminal.
+ */
+void UserInterface::toggleTrace() {
+    if (!Trace::isRunning()) {
+        Trace::start();
+        traceStatus = "Tracing (F4 to stop)";
+    } else {
+        Trace::stop();
+        const QString path = "pilluminate-trace.json";
+        traceStatus = Trace::write(path) ? "Trace written to " + path : "Could not write trace to " + path;
+    }
+    showStats();
+}
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+/**
+ * @brief Shows or hides the performance overlay.
+ */
+void UserInterface::togglePerfOverlay() {
+    Trace::Span span("UserInterface::togglePerfOverlay");
+    perfOverlay->setVisible(!perfOverlay->isVisible());
+}
+#endif
+
 /**
  * @brief Creates the control panel with action buttons for the user interface.
  * @details Sets up a horizontal layout filled with buttons that provide user actions such as adding new LEDs, turning all LEDs on or off, changing colors, and more. This method encapsulates the initialization and configuration of the control panel's buttons and their signal-slot connections.
  */
 void UserInterface::createControlPanel() {
 
-    controlLayout = new QHBoxLayout(); // Layout for control buttons.
+    controlPanel = new QWidget(this); // Container for the control buttons, carrying their style sheet.
+    controlLayout = new QHBoxLayout(controlPanel); // Layout for control buttons.
+    controlLayout->setContentsMargins(0, 0, 0, 0);
 
     // Initializing control buttons.
     addButton = new QPushButton("Add LED", this);
+    addMultipleButton = new QPushButton("Add Multiple LEDs", this);
     allOnButton = new QPushButton("Turn All LEDs On", this);
     allOffButton = new QPushButton("Turn All LEDs Off", this);
+    removeOffButton = new QPushButton("Remove Off LEDs", this);
     removeAllButton = new QPushButton("Remove All LEDs", this);
     changeAllColorButton = new QPushButton("Change All Colors", this);
     setAllBlinkSpeedButton = new QPushButton("Set All Blink Speed", this);
     setDurationButton = new QPushButton("Set All Duration", this);
+    effectButton = new QPushButton("Effects", this);
+    correctionButton = new QPushButton("Color Correction", this);
     helpButton = new QPushButton("Help", this);
 
     // Adding buttons to the layout.
     controlLayout->addWidget(addButton);
+    controlLayout->addWidget(addMultipleButton);
     controlLayout->addWidget(allOnButton);
     controlLayout->addWidget(allOffButton);
+    controlLayout->addWidget(removeOffButton);
     controlLayout->addWidget(removeAllButton);
     controlLayout->addWidget(changeAllColorButton);
     controlLayout->addWidget(setAllBlinkSpeedButton); 
     controlLayout->addWidget(setDurationButton);
+    controlLayout->addWidget(effectButton);
+    controlLayout->addWidget(correctionButton);
     controlLayout->addWidget(helpButton);
-    mainLayout->addLayout(controlLayout); 
+    mainLayout->addWidget(controlPanel);
+
+    // Style setup for the buttons. The sheet is set on the panel rather than the window, so that it does not cascade onto the LED view.
+    controlPanel->setStyleSheet("QPushButton { background-color: #2E8B57; color: white; border-radius: 5px; padding: 6px; margin: 6px; }"
+                                "QPushButton:hover { background-color: #3CB371; }");
 
     // Connecting buttons to their respective slots.
     connect(addButton, &QPushButton::clicked, this, &UserInterface::addNewLED);
+    connect(addMultipleButton, &QPushButton::clicked, this, &UserInterface::addMultipleLEDs);
     connect(allOnButton, &QPushButton::clicked, this, &UserInterface::turnAllLEDsOn);
     connect(allOffButton, &QPushButton::clicked, this, &UserInterface::turnAllLEDsOff);
+    connect(removeOffButton, &QPushButton::clicked, this, &UserInterface::removeOffLEDs);
     connect(removeAllButton, &QPushButton::clicked, this, &UserInterface::removeAllLEDs);
     connect(changeAllColorButton, &QPushButton::clicked, this, &UserInterface::changeAllLEDsColor);
     connect(setAllBlinkSpeedButton, &QPushButton::clicked, this, &UserInterface::setAllLEDsBlinkSpeed);
     connect(setDurationButton, &QPushButton::clicked, this, &UserInterface::setDurationForOnLEDs);
+    connect(effectButton, &QPushButton::clicked, this, &UserInterface::chooseEffect);
+    connect(correctionButton, &QPushButton::clicked, this, &UserInterface::adjustColorCorrection);
     connect(helpButton, &QPushButton::clicked, this, &UserInterface::showHelpDialog);
 
 }
 
 /**
  * @brief Finds an LED by its ID.
- * @details Searches the list of LEDs for one with a matching ID. If found, it returns a pointer to the LED. Otherwise, it returns nullptr. This function is essential for operations that target a specific LED, such as changing its color or removing it.
+ * @details Decodes the slot from the ID, which is a generational handle, so the cost does not depend on the number of LEDs. If the LED still exists, it returns a pointer to the LED, creating the VirtualLED and its signal-slot connection on first use. Otherwise, including when the ID belongs to an LED that was removed, it returns nullptr. This function is essential for operations that target a specific LED, such as changing its color or removing it.
  * @param id The ID of the LED to find.
  * @return A pointer to the found VirtualLED, or nullptr if no LED with the given ID is found.
  */
 VirtualLED* UserInterface::findLEDById(int id) {
-    for (VirtualLED *led : leds) {if (led->getId() == id) {return led;}} // Returning the found LED.
-    return nullptr; // No LED found with the specified ID.
-}
 
-/**
- * @brief Updates the layout of LEDs in the grid.
- * @details Clears the current grid layout and re-adds each LED in its appropriate position based on a pre-defined number of columns. This method is called after adding or removing LEDs to ensure the display is updated correctly.
- */
-void UserInterface::updateGridLayout() {
+    int slot = store.slotOf(id); // Looking up the LED's slot.
+    if (slot < 0) {return nullptr;} // No LED has the specified ID.
 
-    // Clearing existing items in the grid layout.
-    while (QLayoutItem* item = ledsGrid->takeAt(0)) { 
-        if (QWidget* widget = item->widget()) {widget->hide();} // Hiding the widget before deletion to improve UI performance.
-        delete item; // Deleting the layout item, which removes it from the layout.
+    if (!leds.at(slot)) {
+        leds[slot] = new VirtualLED(controller, id, this);
+        connect(leds.at(slot), &VirtualLED::changed, this, &UserInterface::scheduleRepaint); // Repainting the LED's cell whenever its appearance changes.
     }
+    return leds.at(slot);
 
-    int row, col;
-    const int cols = 5; // Number of columns in the grid.
+}
 
-    // Adding LEDs to the grid, calculating their position based on the index.
-    for (int i = 0; i < leds.size(); ++i) {
-        row = i / cols; // Calculating the row index.
-        col = i % cols; // Calculating the column index.
-        ledsGrid->addWidget(leds.at(i), row, col); // Adding the LED widget to the grid at the calculated position.
-        leds.at(i)->show(); // Ensuring the LED widget is visible.
-    }
+/**
+ * @brief Gives read access to the state of the LEDs.
+ * @return The store holding every LED.
+ */
+const LedStore &UserInterface::ledStore() const {
+    return store;
+}
 
+/**
+ * @brief Updates the layout of LEDs in the grid.
+ * @details The LED view computes each LED's position from its index, so there is nothing to rebuild. This method tells the view that the set of LEDs changed arbitrarily so that the scroll area picks up the new height and the whole grid is repainted. Adding or removing a single LED uses the view's incremental updates instead.
+ */
+void UserInterface::updateGridLayout() {
+    Trace::Span span("UserInterface::updateGridLayout");
+    ledView->refreshLayout();
+    output.update();
+    controller->clearDirty(); // The whole grid is repainted anyway.
 }
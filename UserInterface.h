@@ -8,21 +8,28 @@
 #ifndef USERINTERFACE_H
 #define USERINTERFACE_H
 
+#include "include/interfaces/LedMatrixView.h"
+#include "include/models/LedController.h"
 #include "include/models/VirtualLED.h"
 
 // Including necessary modules.
-#include <QGridLayout>
 #include <QHBoxLayout>
-#include <QList>
+#include <QLabel>
 #include <QPushButton>
-#include <QScrollArea>
+#include <QTimer>
 #include <QVBoxLayout>
+#include <QVector>
 #include <QWidget>
+#include <functional>
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+#include "include/interfaces/PerfOverlay.h"
+#endif
 
 /**
  * @class UserInterface
  * @brief Represents the main user interface for managing VirtualLED objects. Provides functionality for adding, removing, and manipulating the state and appearance of VirtualLEDs through a graphical interface.
- * @details This class inherits from QWidget and makes use of Qt's layout management to organize UI components. It allows the user to interact with VirtualLED objects in a visual and intuitive manner.
+ * @details This class inherits from QWidget and makes use of Qt's layout management to organize UI components. It allows the user to interact with VirtualLED objects in a visual and intuitive manner. The operations themselves are carried out by LedController, which the headless CommandInterface shares, so this class only asks for input, shows warnings and keeps the view in step.
  * @author Group 3
  */
 class UserInterface : public QWidget { 
@@ -44,14 +51,69 @@ public:
      */
     virtual ~UserInterface() override; 
 
+    /**
+     * @brief Adds a number of LEDs at once.
+     * @details Allocates storage for all of them up front and performs one layout pass, one repaint and one log line, regardless of the count. Nothing is added if the store has no room for all of them.
+     * @param count The number of LEDs to add.
+     * @return bool True if the LEDs were added, false if they would exceed LedStore::MaxSlots.
+     */
+    bool addLEDs(int count);
+
+    /**
+     * @brief Removes a range of LEDs at once.
+     * @details Removes the LEDs at the given display positions with one layout pass, one repaint and one log line.
+     * @param first The display position of the first LED to remove.
+     * @param count The number of LEDs to remove. The range is clipped to the existing LEDs.
+     */
+    void removeLEDs(int first, int count);
+
+    /**
+     * @brief Removes every LED matching a predicate at once.
+     * @details Removes the matching LEDs with one layout pass, one repaint and one log line.
+     * @param predicate Function called with the slot of each LED, returning true for LEDs to remove.
+     */
+    void removeLEDs(const std::function<bool(int)> &predicate);
+
+    /**
+     * @brief Changes the color of every LED that is on.
+     * @details Writes the color array in one pass and repaints the view once. LEDs that are off keep their state.
+     * @param color The new color.
+     */
+    void setOnLEDsColor(const QColor &color);
+
+    /**
+     * @brief Sets the blinking speed of every LED that is on.
+     * @details Writes the period array in one pass and repaints the view once.
+     * @param speed The blinking speed in milliseconds, 0 to stop blinking.
+     */
+    void setOnLEDsBlinkSpeed(int speed);
+
+    /**
+     * @brief Gives read access to the state of the LEDs.
+     * @return const LedStore& The store holding every LED.
+     */
+    const LedStore &ledStore() const;
+
 private slots:
 
     /**
      * @brief Adds a new LED to the interface.
-     * @details Dynamically creates a new VirtualLED object and adds it to the interface for display and interaction.
+     * @details Appends a single LED to the store and places its cell in the grid. Displays a warning if the store is full.
      */
     void addNewLED(); 
 
+    /**
+     * @brief Adds a user-chosen number of LEDs.
+     * @details Asks for the number of LEDs in a dialog and adds them in one bulk operation.
+     */
+    void addMultipleLEDs();
+
+    /**
+     * @brief Removes every LED that is off.
+     * @details Removes all LEDs that are currently off in one bulk operation. Displays a warning if no LED is off.
+     */
+    void removeOffLEDs();
+
     /**
      * @brief Turns all LEDs on.
      * @details Iterates through all VirtualLED objects managed by the interface and sets their state to 'on'.
@@ -77,12 +139,6 @@ private slots:
      */
     void removeLED(int id); 
 
-    /**
-     * @brief Reassigns IDs to all LEDs following a removal to ensure continuity.
-     * @details Ensures that after any LED removal, the remaining LEDs have continuous IDs, with no gaps in the sequence.
-     */
-    void reassignLEDIds(); 
-
     /**
      * @brief Changes the color of a specific LED.
      * @details Sets the color of the specified VirtualLED object to the new color provided.
@@ -91,6 +147,27 @@ private slots:
      */
     void changeLEDColor(int id, const QColor &color); 
 
+    /**
+     * @brief Toggles a specific LED on or off.
+     * @details Turns the LED with the specified ID off if it is on, or on if it is off.
+     * @param id The ID of the LED.
+     */
+    void toggleLED(int id);
+
+    /**
+     * @brief Sets the blink speed of a specific LED.
+     * @param id The ID of the LED.
+     * @param speed The blinking speed in milliseconds, 0 to stop blinking.
+     */
+    void setLEDBlinkSpeed(int id, int speed);
+
+    /**
+     * @brief Sets how long a specific LED stays on.
+     * @param id The ID of the LED.
+     * @param seconds The duration in seconds.
+     */
+    void setLEDDuration(int id, int seconds);
+
     /**
      * @brief Changes the color of all LEDs.
      * @details Opens a color picker dialog allowing the user to select a color, which is then applied to all VirtualLED objects.
@@ -115,15 +192,77 @@ private slots:
      */
     void showHelpDialog(); 
 
+    /**
+     * @brief Asks for the LEDs that changed to be repainted.
+     * @details Queues a single call to repaintDirty() however often it is called before the event loop runs again.
+     */
+    void scheduleRepaint();
+
+    /**
+     * @brief Repaints the LEDs that changed since the last repaint.
+     * @details Corrects the colors of the dirty LEDs in the output frame, hands the store's dirty flags to the view and clears them.
+     */
+    void repaintDirty();
+
+    /**
+     * @brief Starts or stops an effect.
+     * @details Asks for the effect and its colors in dialogs and hands the effect to the effect engine.
+     */
+    void chooseEffect();
+
+    /**
+     * @brief Changes the color correction.
+     * @details Asks for the gamma, the brightness, the white balance and whether to dither in dialogs and repaints every LED if they changed.
+     */
+    void adjustColorCorrection();
+
+    /**
+     * @brief Shows the next frame of the temporal dithering.
+     * @details Connected to the dithering timer. Advances the dithering of the output frame as of its last update and repaints the visible LEDs.
+     */
+    void ditherFrame();
+
+    /**
+     * @brief Refreshes the statistics shown below the LEDs.
+     * @details Called once per second; shows how many LEDs there are, how many are on, blinking and timed, and how many timer wakeups happened during the last second.
+     */
+    void updateStats();
+
+    /**
+     * @brief Starts or stops tracing.
+     * @details Bound to F4. Stopping writes the recorded spans to pilluminate-trace.json in the working directory. The outcome is shown after the statistics.
+     */
+    void toggleTrace();
+
+#ifdef PILLUMINATE_PERF_OVERLAY
+    /**
+     * @brief Shows or hides the performance overlay.
+     * @details Bound to F3. The overlay only measures while it is shown.
+     */
+    void togglePerfOverlay();
+#endif
+
 private:
 
     QVBoxLayout *mainLayout; // Main layout of the user interface.
+    QWidget *controlPanel; // Widget holding the control buttons and their style sheet.
     QHBoxLayout *controlLayout; // Layout for control buttons.
-    QGridLayout *ledsGrid; // Grid layout for displaying LEDs.
-    QScrollArea *ledsContainer; // Scroll area containing the grid of LEDs.
-    QPushButton *addButton, *allOnButton, *allOffButton, *removeAllButton, *changeAllColorButton, * setAllBlinkSpeedButton, *setDurationButton, *helpButton; ///< Control buttons. 
-    QList<VirtualLED*> leds; // List of current VirtualLED objects.
-    int nextLedId = 1; // ID to be assigned to the next added LED.
+    LedMatrixView *ledView; // Scrollable canvas that draws the grid of LEDs.
+    QPushButton *addButton, *addMultipleButton, *allOnButton, *allOffButton, *removeOffButton, *removeAllButton, *changeAllColorButton, * setAllBlinkSpeedButton, *setDurationButton, *effectButton, *correctionButton, *helpButton; ///< Control buttons. 
+    LedController *controller; // Owner of the LEDs and of every operation on them.
+    const LedStore &store; // State of every LED, indexed by slot; the controller's store.
+    OutputFrame &output; // Color corrected colors of the LEDs, which the view draws; the controller's output frame.
+    QVector<VirtualLED*> leds; // VirtualLED of each slot in the store, created on first use; nullptr for free slots and LEDs not accessed individually yet.
+    QLabel *statsLabel; // Label showing the LED counts and timer wakeups per second.
+    QTimer *statsTimer; // Timer refreshing the statistics label once per second.
+    QTimer *ditherTimer; // Timer advancing the temporal dithering once per frame, running only while it has an effect.
+    quint64 lastWakeupCount = 0; // Wakeup count at the previous statistics refresh.
+    quint64 wakeupsPerSecond = 0; // Wakeups during the second before the previous statistics refresh.
+    QString traceStatus; // Outcome of the last start or stop of tracing, shown after the statistics; empty until tracing is first toggled.
+    bool repaintPending = false; // Whether a call to repaintDirty() is queued.
+#ifdef PILLUMINATE_PERF_OVERLAY
+    PerfOverlay *perfOverlay; // Overlay with frame, paint and layout figures, hidden by default.
+#endif
 
     /**
      * @brief Initializes and sets up the control panel.
@@ -133,7 +272,7 @@ private:
 
     /**
      * @brief Finds an LED by its ID.
-     * @details Searches the list of VirtualLED objects for one with the specified ID and returns a pointer to it. If no such LED exists, nullptr is returned.
+     * @details Decodes the slot from the ID, which is a generational handle, in O(1) and returns a pointer to the VirtualLED in that slot, creating it on first use. If no such LED exists, or the ID belongs to a removed LED, nullptr is returned.
      * @param id ID of the LED to find.
      * @return Pointer to the VirtualLED object, or nullptr if not found.
      */
@@ -141,10 +280,29 @@ private:
 
     /**
      * @brief Updates the layout to reflect the current state of the LEDs list.
-     * @details Adjusts the grid layout to accurately display all VirtualLED objects according to their current states and positions. This method is called after modifications to the LED list to ensure the UI remains up to date.
+     * @details Tells the LED view that the set of LEDs changed so that it resizes and repaints the whole grid. Used after bulk changes such as removing all LEDs; single additions and removals update the view incrementally.
      */
     void updateGridLayout(); 
 
+    /**
+     * @brief Shows the statistics and the tracing status in the statistics label.
+     * @details Uses the wakeups counted at the previous refresh, so that it can be called between refreshes without skewing them.
+     */
+    void showStats();
+
+    /**
+     * @brief Deletes the VirtualLED objects of slots that are no longer live.
+     * @details Used after the controller removed LEDs on its own terms, such as all LEDs that are off.
+     */
+    void dropRemovedLEDs();
+
+    /**
+     * @brief Removes the LEDs in a set of slots.
+     * @details Shared by the bulk removal operations. Deletes the VirtualLED objects, has the controller free the slots and log one line, and refreshes the grid once.
+     * @param targets The slots of the LEDs to remove. Must be live and distinct.
+     */
+    void removeSlots(const QVector<int> &targets);
+
 };
 
 #endif // USERINTERFACE_H
@@ -0,0 +1,6 @@
+TARGET = Pilluminate
+TEMPLATE = app
+
+include(Pilluminate.pri)
+
+SOURCES += src/main.cpp
@@ -1,14 +1,34 @@
 /**
  * @file main.cpp
  * @brief Entry point for the Qt application that opens a user interface window.
- * @details This file contains the main function that initializes a QApplication, creates a UserInterface instance, and controls the application's execution flow. The application initializes with the QApplication object, sets up the UserInterface, and enters the event loop until exit.
+ * @details This file contains the main function that initializes a QApplication, creates a UserInterface instance, and controls the application's execution flow. The application initializes with the QApplication object, sets up the UserInterface, and enters the event loop until exit. Started with --headless anywhere on the command line, it runs the LED model on a QCoreApplication without any widgets and takes commands from standard input, or from a local socket when started with --headless=<name>. With --trace=<file>, trace spans are recorded from the start and written to the file as Chrome trace events on exit. The event log is configured from the command line with --log-level=debug|info|warning|off and --log-each-led, which writes the per-LED records of bulk operations instead of one summary each.
  * @author Group 3
  */
 
 // Including necessary modules.
 #include <QApplication>
+#include <QCoreApplication>
 #include <QDebug>
+#include "include/interfaces/CommandInterface.h"
 #include "include/interfaces/UserInterface.h"
+#include "include/utils/EventLog.h"
+#include "include/utils/Trace.h"
+
+/**
+ * @brief Shuts down the background services before the application exits.
+ * @details Writes the trace if one was requested and flushes the event log.
+ * @param result The exit code of the application.
+ * @param tracePath The file to write the trace to, or empty if tracing was not requested.
+ * @return Integer exit code of the application.
+ */
+static int finish(int result, const QString &tracePath) {
+    if (!tracePath.isEmpty()) {
+        Trace::stop();
+        if (!Trace::write(tracePath)) {qWarning() << "Could not write trace to" << tracePath;}
+    }
+    EventLog::stop(); // Writes the remaining log records.
+    return result;
+}
 
 /**
  * @brief Main function of the application.
@@ -19,11 +39,39 @@
  * @author Group 3
  */
 int main(int argc, char *argv[]) {
+    QString tracePath;
+    bool headless = false;
+    QString socketName; // Empty for standard input.
+    for (int i = 1; i < argc; ++i) { // Configuring the frontend, the event log and tracing.
+        if (qstrcmp(argv[i], "--headless") == 0) {headless = true;}
+        else if (qstrncmp(argv[i], "--headless=", 11) == 0) {
+            headless = true;
+            socketName = QString::fromLocal8Bit(argv[i] + 11);
+        }
+        else if (qstrcmp(argv[i], "--log-level=debug") == 0) {EventLog::setLevel(EventLog::Debug);}
+        else if (qstrcmp(argv[i], "--log-level=info") == 0) {EventLog::setLevel(EventLog::Info);}
+        else if (qstrcmp(argv[i], "--log-level=warning") == 0) {EventLog::setLevel(EventLog::Warning);}
+        else if (qstrcmp(argv[i], "--log-level=off") == 0) {EventLog::setLevel(EventLog::Off);}
+        else if (qstrcmp(argv[i], "--log-each-led") == 0) {EventLog::setAggregation(false);}
+        else if (qstrncmp(argv[i], "--trace=", 8) == 0) {tracePath = QString::fromLocal8Bit(argv[i] + 8);}
+    }
+    EventLog::start(); // Starts writing log records in the background.
+    if (!tracePath.isEmpty()) {Trace::start();}
+    if (headless) { // Running the LED model without any widgets.
+        QCoreApplication app(argc, argv);
+        CommandInterface commands;
+        if (socketName.isEmpty()) {commands.readStandardInput();}
+        else if (!commands.listen(socketName)) {
+            qCritical() << "Could not listen on local socket" << socketName;
+            return finish(1, tracePath);
+        }
+        return finish(app.exec(), tracePath);
+    }
     QApplication app(argc, argv); // Initializes the application with command-line arguments.
     UserInterface ui; // Creates the user interface.
     ui.showMaximized(); // Displays the user interface window maximized.
     qDebug() << "Application window opened."; // Debug message indicating window is open.
     int result = app.exec(); // Enters the main event loop and waits until exit.
     qDebug() << "Application window closed."; // Debug message indicating window has been closed.
-    return result; // Returns the result of the event loop execution.
+    return finish(result, tracePath); // Returns the result of the event loop execution.
 }
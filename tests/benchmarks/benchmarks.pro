@@ -0,0 +1,12 @@
+# Benchmarks of the LED models and the interface's hot paths, run with "make benchmark" rather than "make check".
+QT += testlib widgets
+
+CONFIG += testcase benchmark
+CONFIG -= app_bundle
+
+TARGET = tst_benchmarks
+TEMPLATE = app
+
+include(../../Pilluminate.pri)
+
+SOURCES += tst_benchmarks.cpp
@@ -0,0 +1,749 @@
+/**
+ * @file tst_benchmarks.cpp
+ * @brief Benchmarks of the LED models and the interface's hot paths.
+ * @details This file contains the Benchmarks test case, which measures the core LED operations with QBENCHMARK. It runs on the offscreen platform unless another one is requested, so that it needs no display. QtTest prints the results; run it with -csv, or with -o <file>,csv or -o <file>,xml, to get them in a machine-readable form that runs of different builds can be compared with.
+ * @author Group 3
+ */
+
+#include "include/interfaces/LedMatrixView.h"
+#include "include/interfaces/UserInterface.h"
+#include "include/models/EffectEngine.h"
+#include "include/models/Effects.h"
+#include "include/models/LedStore.h"
+#include "include/models/OutputFrame.h"
+#include "include/utils/ColorSpaces.h"
+#include "include/utils/CpuFeatures.h"
+
+// Including necessary modules.
+#include <QApplication>
+#include <QColor>
+#include <QRandomGenerator>
+#include <QScopedPointer>
+#include <QVector>
+#include <QtTest>
+
+namespace {
+
+const quint32 Seed = 42; // Fixed seed so that every run uses the same inputs.
+const int PixelCount = 1 << 20; // Number of LEDs of the effect, correction and conversion benchmarks.
+
+}
+
+/**
+ * @class Benchmarks
+ * @brief Collection of QBENCHMARK measurements for the LED models and the interface.
+ * @details Each benchmark builds its own LedStore or UserInterface outside the measured block and generates its inputs with a fixed seed, so that runs are comparable. Operations that can be repeated without changing what they measure use QBENCHMARK and are reported per call; operations that change the number of LEDs are measured once over a fixed batch with QBENCHMARK_ONCE, so the LED count stays the one in the row name. Benchmarks of the interface show its window and process events after every operation, so that layout and painting are included.
+ * @author Group 3
+ */
+class Benchmarks : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Restores the instruction set after benchmarks that lower it.
+     */
+    void cleanup();
+
+    /**
+     * @brief Measures 1,000,000 per-ID color changes in a store of 100,000 LEDs.
+     * @details Every change goes through the handle-to-slot lookup; IDs and colors are drawn before measuring.
+     */
+    void randomColorChanges();
+
+    /**
+     * @brief Provides the storage modes for recolors().
+     */
+    void recolors_data();
+
+    /**
+     * @brief Measures moving all LEDs of one color to another color and back, in a store of 100,000 LEDs in 16 colors.
+     */
+    void recolors();
+
+    /**
+     * @brief Provides the update modes for gridAppends().
+     */
+    void gridAppends_data();
+
+    /**
+     * @brief Measures adding 10,000 LEDs to a shown grid one at a time.
+     */
+    void gridAppends();
+
+    /**
+     * @brief Measures adding 100,000 LEDs to a shown window in one call.
+     */
+    void bulkAdd();
+
+    /**
+     * @brief Measures removing every other one of 100,000 LEDs in one call.
+     */
+    void bulkRemove();
+
+    /**
+     * @brief Provides the styling modes for windowConstruction().
+     */
+    void windowConstruction_data();
+
+    /**
+     * @brief Measures building and showing a window with 10,000 LEDs.
+     * @details Construction, polishing and the first paint are measured; destroying the window is not.
+     */
+    void windowConstruction();
+
+    /**
+     * @brief Provides the LED counts for addLED().
+     */
+    void addLED_data();
+
+    /**
+     * @brief Measures adding 100 LEDs one at a time through the slot of the Add LED button.
+     */
+    void addLED();
+
+    /**
+     * @brief Provides the LED counts for removeLED().
+     */
+    void removeLED_data();
+
+    /**
+     * @brief Measures removing 100 LEDs from the middle of the grid one at a time through the slot of the context menu.
+     */
+    void removeLED();
+
+    /**
+     * @brief Provides the LED counts for turnAllLEDsOn().
+     */
+    void turnAllLEDsOn_data();
+
+    /**
+     * @brief Measures turning all LEDs on through the slot of the Turn All LEDs On button.
+     */
+    void turnAllLEDsOn();
+
+    /**
+     * @brief Provides the LED counts for changeAllLEDsColor().
+     */
+    void changeAllLEDsColor_data();
+
+    /**
+     * @brief Measures changing the color of all LEDs through the method behind the Change All Colors dialog.
+     */
+    void changeAllLEDsColor();
+
+    /**
+     * @brief Provides the LED counts for setAllLEDsBlinkSpeed().
+     */
+    void setAllLEDsBlinkSpeed_data();
+
+    /**
+     * @brief Measures setting the blinking speed of all LEDs through the method behind the Set All Blink Speed dialog.
+     */
+    void setAllLEDsBlinkSpeed();
+
+    /**
+     * @brief Provides the supported instruction sets for rainbowFrame().
+     */
+    void rainbowFrame_data();
+
+    /**
+     * @brief Measures rendering one rainbow frame of 1,048,576 LEDs on the calling thread.
+     */
+    void rainbowFrame();
+
+    /**
+     * @brief Provides the effects for effectFrame().
+     */
+    void effectFrame_data();
+
+    /**
+     * @brief Measures rendering one frame of 1,048,576 LEDs on all threads of the effect engine.
+     */
+    void effectFrame();
+
+    /**
+     * @brief Measures a full color correction pass over 1,048,576 LEDs of distinct colors.
+     * @details The correction alternates between two settings, so every pass covers every LED and includes rebuilding the tables, as it does when the correction changes in the interface.
+     */
+    void correctionPass();
+
+    /**
+     * @brief Provides the supported instruction sets for ditherFrame().
+     */
+    void ditherFrame_data();
+
+    /**
+     * @brief Measures one frame of temporal dithering over 1,048,576 LEDs.
+     */
+    void ditherFrame();
+
+    /**
+     * @brief Provides the conversions and supported instruction sets for colorSpaceConversion().
+     */
+    void colorSpaceConversion_data();
+
+    /**
+     * @brief Measures converting 1,048,576 random colors.
+     * @details The throughput in pixels per nanosecond is 1,048,576 divided by the time per iteration.
+     */
+    void colorSpaceConversion();
+
+private:
+
+    /**
+     * @brief Adds the LED counts the interface benchmarks run at.
+     * @details 100, 1,000, 10,000 and 100,000 LEDs, so that the growth of each operation's cost with the number of LEDs shows up in the results.
+     */
+    static void ledCounts();
+
+    /**
+     * @brief Adds a row for every instruction set the processor supports.
+     */
+    static void levels();
+
+};
+
+/**
+ * @brief Adds the LED counts the interface benchmarks run at.
+ */
+void Benchmarks::ledCounts() {
+    QTest::addColumn<int>("ledCount");
+    for (int ledCount : {100, 1000, 10000, 100000}) {QTest::addRow("%d LEDs", ledCount) << ledCount;}
+}
+
+/**
+ * @brief Adds a row for every instruction set the processor supports.
+ */
+void Benchmarks::levels() {
+    QTest::addColumn<int>("level");
+    for (int level = CpuFeatures::Scalar; level <= CpuFeatures::supportedLevel(); ++level) {
+        QTest::newRow(CpuFeatures::name(CpuFeatures::Level(level))) << level;
+    }
+}
+
+/**
+ * @brief Restores the instruction set after benchmarks that lower it.
+ */
+void Benchmarks::cleanup() {
+    CpuFeatures::setLevel(CpuFeatures::supportedLevel());
+}
+
+/**
+ * @brief Measures per-ID color changes.
+ */
+void Benchmarks::randomColorChanges() {
+
+    const int ledCount = 100000;
+    const int changeCount = 1000000;
+
+    LedStore store;
+    store.reserve(ledCount);
+    QVector<int> handles(ledCount);
+    for (int i = 0; i < ledCount; ++i) {handles[i] = store.handleOf(store.append());}
+
+    QRandomGenerator random(Seed);
+    QVector<int> ids(changeCount);
+    QVector<QRgb> colors(changeCount);
+    for (int i = 0; i < changeCount; ++i) {
+        ids[i] = handles.at(random.bounded(ledCount));
+        colors[i] = random.generate() | 0xff000000; // Opaque, as QColor::fromRgb() would make it.
+    }
+
+    QBENCHMARK {
+        for (int i = 0; i < changeCount; ++i) {
+            const int slot = store.slotOf(ids.at(i));
+            store.setRgba(slot, colors.at(i));
+            store.setOn(slot, true);
+        }
+    }
+
+}
+
+/**
+ * @brief Provides the storage modes for recolors().
+ */
+void Benchmarks::recolors_data() {
+    QTest::addColumn<bool>("paletted");
+    QTest::newRow("palette") << true;
+    QTest::newRow("per LED") << false;
+}
+
+/**
+ * @brief Measures recoloring every LED of one color.
+ * @details Each iteration moves the LEDs of one color to a color that is not in use and back, so the paletted store rewrites one entry without merging. The store is forced out of palette mode by giving more LEDs distinct colors than the palette holds.
+ */
+void Benchmarks::recolors() {
+
+    QFETCH(bool, paletted);
+    const int ledCount = 100000;
+    const int colorCount = 16;
+
+    LedStore store;
+    store.reserve(ledCount);
+    for (int i = 0; i < ledCount; ++i) {
+        const int slot = store.append();
+        store.setRgba(slot, qRgb(i % colorCount, 0, 0));
+        store.setOn(slot, true);
+    }
+    if (!paletted) { // More distinct colors than the palette holds, then the original ones again.
+        for (int i = 0; i <= LedStore::PaletteLimit; ++i) {store.setRgba(i, qRgb(0, i % 256, 1 + i / 256));}
+        for (int i = 0; i <= LedStore::PaletteLimit; ++i) {store.setRgba(i, qRgb(i % colorCount, 0, 0));}
+    }
+
+    const QRgb spare = qRgb(255, 255, 255);
+    int step = 0;
+    QBENCHMARK { // Moving color i % 16 to a spare color and back keeps 16 colors in use.
+        const QRgb color = qRgb(step++ % colorCount, 0, 0);
+        store.replaceColor(color, spare);
+        store.replaceColor(spare, color);
+    }
+
+}
+
+/**
+ * @brief Provides the update modes for gridAppends().
+ */
+void Benchmarks::gridAppends_data() {
+    QTest::addColumn<bool>("incremental");
+    QTest::newRow("incremental") << true;
+    QTest::newRow("full refresh") << false;
+}
+
+/**
+ * @brief Measures adding LEDs to the grid one at a time.
+ * @details The view is shown at the size of a typical window and updated either with LedMatrixView::ledsAppended() or with LedMatrixView::refreshLayout() after every LED.
+ */
+void Benchmarks::gridAppends() {
+
+    QFETCH(bool, incremental);
+    const int ledCount = 10000;
+
+    LedStore store;
+    OutputFrame output(store);
+    LedMatrixView view(store, output);
+    view.resize(1280, 720);
+    view.show();
+    QCoreApplication::processEvents();
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < ledCount; ++i) {
+            store.setOn(store.append(), true);
+            if (incremental) {view.ledsAppended(1);}
+            else {view.refreshLayout();}
+            QCoreApplication::processEvents();
+        }
+    }
+
+}
+
+/**
+ * @brief Measures adding LEDs to a shown window in one call.
+ */
+void Benchmarks::bulkAdd() {
+
+    UserInterface ui;
+    ui.resize(1280, 720);
+    ui.show();
+    QCoreApplication::processEvents();
+
+    QBENCHMARK_ONCE {
+        ui.addLEDs(100000);
+        QCoreApplication::processEvents();
+    }
+
+}
+
+/**
+ * @brief Measures removing LEDs by predicate in one call.
+ */
+void Benchmarks::bulkRemove() {
+
+    UserInterface ui;
+    ui.resize(1280, 720);
+    ui.show();
+    ui.addLEDs(100000);
+    QCoreApplication::processEvents();
+
+    QBENCHMARK_ONCE {
+        ui.removeLEDs([](int slot){ return slot % 2 == 0; });
+        QCoreApplication::processEvents();
+    }
+
+}
+
+/**
+ * @brief Provides the styling modes for windowConstruction().
+ * @details The second row puts back the window-wide style sheet the interface used to set, which styles every widget of the window, the LED view included, through QStyleSheetStyle. One run therefore gives the cost of the window as it is and as it was.
+ */
+void Benchmarks::windowConstruction_data() {
+    QTest::addColumn<QString>("styleSheet");
+    QTest::newRow("no window style sheet") << QString();
+    QTest::newRow("window style sheet") << QString("QPushButton { background-color: #2E8B57; color: white; border-radius: 5px; padding: 6px; margin: 6px; }"
+                                                   "QPushButton:hover { background-color: #3CB371; }"
+                                                   "QScrollArea { border: none; }"
+                                                   "QWidget { font-family: 'Arial'; font-size: 14px; }");
+}
+
+/**
+ * @brief Measures building and showing a window with 10,000 LEDs.
+ * @details The window is created on the heap so that it outlives the measured block and is destroyed after it. A style sheet is set right after construction, where the constructor used to set it.
+ */
+void Benchmarks::windowConstruction() {
+
+    QFETCH(QString, styleSheet);
+
+    QScopedPointer<UserInterface> ui;
+    QBENCHMARK_ONCE {
+        ui.reset(new UserInterface);
+        if (!styleSheet.isEmpty()) {ui->setStyleSheet(styleSheet);}
+        ui->resize(1280, 720);
+        ui->addLEDs(10000);
+        ui->show();
+        QCoreApplication::processEvents();
+    }
+
+}
+
+/**
+ * @brief Provides the LED counts for addLED().
+ */
+void Benchmarks::addLED_data() {
+    ledCounts();
+}
+
+/**
+ * @brief Measures adding single LEDs.
+ * @details The slot is private, so it is invoked through the meta-object system, as the button's signal would.
+ */
+void Benchmarks::addLED() {
+
+    QFETCH(int, ledCount);
+
+    UserInterface ui;
+    ui.resize(1280, 720);
+    ui.show();
+    ui.addLEDs(ledCount);
+    QCoreApplication::processEvents();
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < 100; ++i) {
+            QMetaObject::invokeMethod(&ui, "addNewLED");
+            QCoreApplication::processEvents();
+        }
+    }
+
+}
+
+/**
+ * @brief Provides the LED counts for removeLED().
+ */
+void Benchmarks::removeLED_data() {
+    ledCounts();
+}
+
+/**
+ * @brief Measures removing single LEDs.
+ * @details The LEDs are taken from the middle of the display order, so that half of the grid shifts, and 100 extra LEDs are added first so that the requested number remains once they are removed.
+ */
+void Benchmarks::removeLED() {
+
+    QFETCH(int, ledCount);
+    const int removeCount = 100;
+
+    UserInterface ui;
+    ui.resize(1280, 720);
+    ui.show();
+    ui.addLEDs(ledCount + removeCount);
+    QCoreApplication::processEvents();
+
+    const LedStore &store = ui.ledStore();
+    const QVector<int> order = store.displayOrder();
+    QVector<int> ids(removeCount);
+    for (int i = 0; i < removeCount; ++i) {ids[i] = store.handleOf(order.at(ledCount / 2 + i));}
+
+    QBENCHMARK_ONCE {
+        for (int id : ids) {
+            QMetaObject::invokeMethod(&ui, "removeLED", Q_ARG(int, id));
+            QCoreApplication::processEvents();
+        }
+    }
+    QCOMPARE(store.size(), ledCount);
+
+}
+
+/**
+ * @brief Provides the LED counts for turnAllLEDsOn().
+ */
+void Benchmarks::turnAllLEDsOn_data() {
+    ledCounts();
+}
+
+/**
+ * @brief Measures turning all LEDs on.
+ * @details Turning LEDs on that are already on only shows a warning, so the operation is measured once, on LEDs that were just added and are off.
+ */
+void Benchmarks::turnAllLEDsOn() {
+
+    QFETCH(int, ledCount);
+
+    UserInterface ui;
+    ui.resize(1280, 720);
+    ui.show();
+    ui.addLEDs(ledCount);
+    QCoreApplication::processEvents();
+
+    QBENCHMARK_ONCE {
+        QMetaObject::invokeMethod(&ui, "turnAllLEDsOn");
+        QCoreApplication::processEvents();
+    }
+    QCOMPARE(ui.ledStore().onCount(), ledCount);
+
+}
+
+/**
+ * @brief Provides the LED counts for changeAllLEDsColor().
+ */
+void Benchmarks::changeAllLEDsColor_data() {
+    ledCounts();
+}
+
+/**
+ * @brief Measures changing the color of all LEDs.
+ * @details Only LEDs that are on change color, so they are turned on first. Each iteration picks the next of a few random colors, so that every call changes every LED.
+ */
+void Benchmarks::changeAllLEDsColor() {
+
+    QFETCH(int, ledCount);
+
+    UserInterface ui;
+    ui.resize(1280, 720);
+    ui.show();
+    ui.addLEDs(ledCount);
+    QMetaObject::invokeMethod(&ui, "turnAllLEDsOn");
+    QCoreApplication::processEvents();
+
+    QRandomGenerator random(Seed);
+    QVector<QColor> colors(4);
+    for (QColor &color : colors) {color = QColor::fromRgb(random.generate() | 0xff000000);}
+    int step = 0;
+    QBENCHMARK {
+        ui.setOnLEDsColor(colors.at(step++ % colors.size()));
+        QCoreApplication::processEvents();
+    }
+
+}
+
+/**
+ * @brief Provides the LED counts for setAllLEDsBlinkSpeed().
+ */
+void Benchmarks::setAllLEDsBlinkSpeed_data() {
+    ledCounts();
+}
+
+/**
+ * @brief Measures setting the blinking speed of all LEDs.
+ * @details Only LEDs that are on take the speed, so they are turned on first. Each iteration alternates between two speeds, so that every call changes every LED.
+ */
+void Benchmarks::setAllLEDsBlinkSpeed() {
+
+    QFETCH(int, ledCount);
+
+    UserInterface ui;
+    ui.resize(1280, 720);
+    ui.show();
+    ui.addLEDs(ledCount);
+    QMetaObject::invokeMethod(&ui, "turnAllLEDsOn");
+    QCoreApplication::processEvents();
+
+    int step = 0;
+    QBENCHMARK {
+        ui.setOnLEDsBlinkSpeed(100 * (1 + step++ % 2));
+        QCoreApplication::processEvents();
+    }
+
+}
+
+/**
+ * @brief Provides the supported instruction sets for rainbowFrame().
+ */
+void Benchmarks::rainbowFrame_data() {
+    levels();
+}
+
+/**
+ * @brief Measures rendering rainbow frames on the calling thread.
+ * @details Run once per instruction set the processor supports, which shows what each kernel implementation gains.
+ */
+void Benchmarks::rainbowFrame() {
+
+    QFETCH(int, level);
+    CpuFeatures::setLevel(CpuFeatures::Level(level));
+
+    QVector<QRgb> colors(PixelCount);
+    const QSharedPointer<const Effect> rainbow = Effects::create("rainbow");
+    quint64 frame = 0;
+    QBENCHMARK {
+        ++frame;
+        const Effect::Context context = {qint64(frame) * 16, frame, PixelCount};
+        rainbow->render(context, colors.data(), 0, PixelCount);
+    }
+
+}
+
+/**
+ * @brief Provides the effects for effectFrame().
+ */
+void Benchmarks::effectFrame_data() {
+    QTest::addColumn<QString>("name");
+    for (const QString &name : Effects::names()) {QTest::newRow(qPrintable(name)) << name;}
+}
+
+/**
+ * @brief Measures rendering effect frames on all threads.
+ * @details Frames go through EffectEngine::render(), which spreads them over the threads of the engine. The engine is not started, so only the rendering is measured.
+ */
+void Benchmarks::effectFrame() {
+
+    QFETCH(QString, name);
+
+    QVector<QRgb> colors(PixelCount);
+    EffectEngine engine;
+    const QSharedPointer<const Effect> effect = Effects::create(name);
+    quint64 frame = 0;
+    QBENCHMARK {
+        ++frame;
+        const Effect::Context context = {qint64(frame) * 16, frame, PixelCount};
+        engine.render(*effect, context, colors);
+    }
+
+}
+
+/**
+ * @brief Measures correcting the colors of every LED.
+ * @details The LEDs get more distinct colors than the palette holds, so the store keeps one QRgb per LED, as many distinct picked colors make it do.
+ */
+void Benchmarks::correctionPass() {
+
+    LedStore store;
+    store.reserve(PixelCount);
+    QRandomGenerator random(Seed);
+    for (int i = 0; i < PixelCount; ++i) {store.setRgba(store.append(), random.generate() | 0xff000000);}
+    store.clearDirty();
+
+    ColorCorrection::Parameters warm;
+    warm.gamma = 2.2;
+    warm.brightness = 0.8;
+    warm.green = 0.9;
+    warm.blue = 0.7;
+    ColorCorrection::Parameters cool = warm;
+    cool.red = 0.7;
+    cool.blue = 1.0;
+
+    OutputFrame output(store);
+    int step = 0;
+    QBENCHMARK {
+        output.setCorrection(step++ % 2 == 0 ? warm : cool);
+        output.update();
+    }
+
+}
+
+/**
+ * @brief Provides the supported instruction sets for ditherFrame().
+ */
+void Benchmarks::ditherFrame_data() {
+    levels();
+}
+
+/**
+ * @brief Measures dithering the colors of every LED.
+ * @details Dithering is measured on its own, as the interface runs it on every frame whether or not any color changed.
+ */
+void Benchmarks::ditherFrame() {
+
+    QFETCH(int, level);
+
+    LedStore store;
+    store.reserve(PixelCount);
+    QRandomGenerator random(Seed);
+    for (int i = 0; i < PixelCount; ++i) {store.setRgba(store.append(), random.generate() | 0xff000000);}
+    store.clearDirty();
+
+    OutputFrame output(store);
+    ColorCorrection::Parameters parameters;
+    parameters.gamma = 2.2;
+    parameters.brightness = 0.8;
+    output.setCorrection(parameters);
+    output.setDithering(true);
+    output.update();
+
+    CpuFeatures::setLevel(CpuFeatures::Level(level));
+    QBENCHMARK {
+        output.dither();
+    }
+
+}
+
+/**
+ * @brief Provides the conversions and supported instruction sets for colorSpaceConversion().
+ */
+void Benchmarks::colorSpaceConversion_data() {
+    QTest::addColumn<QString>("conversion");
+    QTest::addColumn<int>("level");
+    for (const char *conversion : {"hsv to rgb", "hsl to rgb", "rgb to hsv"}) {
+        for (int level = CpuFeatures::Scalar; level <= CpuFeatures::supportedLevel(); ++level) {
+            QTest::addRow("%s, %s", conversion, CpuFeatures::name(CpuFeatures::Level(level))) << QString(conversion) << level;
+        }
+    }
+}
+
+/**
+ * @brief Measures converting random colors.
+ * @details The colors are random, so that the time per iteration is that of a typical mix of hue sectors.
+ */
+void Benchmarks::colorSpaceConversion() {
+
+    QFETCH(QString, conversion);
+    QFETCH(int, level);
+
+    QRandomGenerator random(Seed);
+    QVector<ColorSpaces::Hsv> hsv(PixelCount);
+    QVector<ColorSpaces::Hsl> hsl(PixelCount);
+    QVector<QRgb> rgb(PixelCount);
+    for (int i = 0; i < PixelCount; ++i) {
+        const quint32 bits = random.generate();
+        const qint16 hue = qint16(random.bounded(360));
+        hsv[i] = {hue, quint8(bits), quint8(bits >> 8)};
+        hsl[i] = {hue, quint8(bits >> 16), quint8(bits >> 24)};
+        rgb[i] = random.generate() | 0xff000000;
+    }
+    QVector<QRgb> colors(PixelCount);
+
+    CpuFeatures::setLevel(CpuFeatures::Level(level));
+    if (conversion == "hsv to rgb") {
+        QBENCHMARK {ColorSpaces::hsvToRgb(hsv.constData(), colors.data(), PixelCount);}
+    } else if (conversion == "hsl to rgb") {
+        QBENCHMARK {ColorSpaces::hslToRgb(hsl.constData(), colors.data(), PixelCount);}
+    } else {
+        QBENCHMARK {ColorSpaces::rgbToHsv(rgb.constData(), hsv.data(), PixelCount);}
+    }
+
+}
+
+/**
+ * @brief Entry point of the benchmarks.
+ * @details Selects the offscreen platform before the application is created, unless another one is requested, so that the windows are never shown on a display.
+ * @param argc Number of command-line arguments, passed on to QtTest.
+ * @param argv Array of command-line argument strings.
+ * @return Integer exit code, the number of failed checks.
+ */
+int main(int argc, char *argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {qputenv("QT_QPA_PLATFORM", "offscreen");}
+    QApplication app(argc, argv);
+    Benchmarks benchmarks;
+    return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "tst_benchmarks.moc"
@@ -0,0 +1,12 @@
+# Tests of the temporal dithering at every supported instruction set, run with "make check".
+QT += testlib
+
+CONFIG += testcase
+CONFIG -= app_bundle
+
+TARGET = tst_colorcorrection
+TEMPLATE = app
+
+include(../../Pilluminate.pri)
+
+SOURCES += tst_colorcorrection.cpp
@@ -0,0 +1,279 @@
+/**
+ * @file tst_colorcorrection.cpp
+ * @brief Tests of the temporal dithering.
+ * @details This file contains the ColorCorrectionTest test case, which checks ColorCorrection::dither() at every instruction set the processor supports against the scalar implementation and against the levels it dithers, and checks that OutputFrame starts every LED's dithering over, so that a regression in any kernel or in the residual bookkeeping fails "make check".
+ * @author Group 3
+ */
+
+#include "include/models/OutputFrame.h"
+#include "include/utils/ColorCorrection.h"
+#include "include/utils/CpuFeatures.h"
+
+// Including necessary modules.
+#include <QRandomGenerator>
+#include <QVector>
+#include <QtTest>
+
+namespace {
+
+const quint32 Seed = 42; // Fixed seed so that every run uses the same inputs.
+const int RandomCount = 100003; // Number of random colors, not a multiple of any vector width so that the scalar tails run as well.
+const int FrameCount = 256; // Number of frames dithered, after which every residual has come full circle.
+const quint64 MaxLevel = 0xff00; // Largest 8.8 level of a channel, 255.0.
+
+/**
+ * @brief Packs four 8.8 levels into a linear color.
+ * @param alpha The alpha level.
+ * @param red The red level.
+ * @param green The green level.
+ * @param blue The blue level.
+ * @return The linear color.
+ */
+quint64 linearColor(quint64 alpha, quint64 red, quint64 green, quint64 blue) {
+    return (alpha << 48) | (red << 32) | (green << 16) | blue;
+}
+
+/**
+ * @brief Gets one channel of a linear color.
+ * @param linear The linear color.
+ * @param shift The position of the channel in the 8-bit color, 0 for blue up to 24 for alpha.
+ * @return The 8.8 level of the channel.
+ */
+int linearChannel(quint64 linear, int shift) {
+    return int((linear >> (2 * shift)) & 0xffff);
+}
+
+}
+
+/**
+ * @class ColorCorrectionTest
+ * @brief Checks the temporal dithering at every supported instruction set.
+ * @details The inputs are random levels up to 255.0 in every channel, with alpha as a whole level as ColorCorrection::mapLinear() produces it, followed by the levels next to the top of the range.
+ * @author Group 3
+ */
+class ColorCorrectionTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Builds the inputs.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Restores the instruction set after each test.
+     */
+    void cleanup();
+
+    /**
+     * @brief Provides the supported instruction sets for the tests run at each of them.
+     */
+    void averagesToLevel_data();
+
+    /**
+     * @brief Checks that the output of every channel averages to its level over the frames.
+     */
+    void averagesToLevel();
+
+    /**
+     * @brief Provides the supported instruction sets for topLevels().
+     */
+    void topLevels_data();
+
+    /**
+     * @brief Checks that the largest level plus the largest residual gives full intensity without overflowing into the next channel.
+     */
+    void topLevels();
+
+    /**
+     * @brief Checks that every vector implementation gives bit-identical colors and residuals to the scalar one in every frame.
+     */
+    void matchesScalar();
+
+    /**
+     * @brief Checks that an LED taking over a freed slot starts its dithering without the removed LED's residual.
+     */
+    void reusedSlotStartsOver();
+
+private:
+
+    QVector<quint64> linear; // Linear colors dithered by every test.
+
+};
+
+/**
+ * @brief Builds the inputs.
+ */
+void ColorCorrectionTest::initTestCase() {
+
+    QRandomGenerator random(Seed);
+    for (int i = 0; i < RandomCount; ++i) {
+        linear.append(linearColor(quint64(random.bounded(256)) << 8, random.bounded(int(MaxLevel) + 1), random.bounded(int(MaxLevel) + 1), random.bounded(int(MaxLevel) + 1)));
+    }
+    for (quint64 level = MaxLevel - 0x100; level <= MaxLevel; ++level) {linear.append(linearColor(0xff00, level, level, level));}
+
+}
+
+/**
+ * @brief Restores the instruction set after each test.
+ */
+void ColorCorrectionTest::cleanup() {
+    CpuFeatures::setLevel(CpuFeatures::supportedLevel());
+}
+
+/**
+ * @brief Provides the supported instruction sets.
+ */
+void ColorCorrectionTest::averagesToLevel_data() {
+    QTest::addColumn<int>("level");
+    for (int level = CpuFeatures::Scalar; level <= CpuFeatures::supportedLevel(); ++level) {
+        QTest::newRow(CpuFeatures::name(CpuFeatures::Level(level))) << level;
+    }
+}
+
+/**
+ * @brief Checks that the output of every channel averages to its level over the frames.
+ * @details Starting from no residual, the outputs of 256 frames add up to exactly the 8.8 level, since the residual left after them is a whole multiple of 256 and below it. The first color that is off is named in the failure message.
+ */
+void ColorCorrectionTest::averagesToLevel() {
+
+    QFETCH(int, level);
+    CpuFeatures::setLevel(CpuFeatures::Level(level));
+
+    const int count = linear.size();
+    QVector<quint32> residuals(count, 0); // Every color is seen for the first time.
+    QVector<QRgb> colors(count);
+    QVector<int> sums(4 * count, 0); // Output of each channel added up over the frames.
+    for (int frame = 0; frame < FrameCount; ++frame) {
+        ColorCorrection::dither(linear.constData(), residuals.data(), colors.data(), count);
+        for (int i = 0; i < count; ++i) {
+            for (int channel = 0; channel < 4; ++channel) {sums[4 * i + channel] += (colors.at(i) >> (8 * channel)) & 0xff;}
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            const int sum = sums.at(4 * i + shift / 8);
+            if (sum != linearChannel(linear.at(i), shift)) { // Building the message only on failure, as there are millions of checks.
+                QFAIL(qPrintable(QString("Linear color %1 averages to %2 instead of %3 in the channel at bit %4")
+                                 .arg(linear.at(i), 16, 16, QChar('0')).arg(sum).arg(linearChannel(linear.at(i), shift)).arg(shift)));
+            }
+        }
+    }
+
+}
+
+/**
+ * @brief Provides the supported instruction sets for topLevels().
+ */
+void ColorCorrectionTest::topLevels_data() {
+    averagesToLevel_data();
+}
+
+/**
+ * @brief Checks the top of the range.
+ * @details A channel at 255.0 whose residual is 255 sums to 0xffff, the largest value the vector implementations hold in 16 bits; it must show as 255 and keep its residual. One step below, 254 and 255/256, must show as 255 as well and leave a residual of 254.
+ */
+void ColorCorrectionTest::topLevels() {
+
+    QFETCH(int, level);
+    CpuFeatures::setLevel(CpuFeatures::Level(level));
+
+    const int count = 37; // Not a multiple of any vector width, so that the scalar tail runs as well.
+    QVector<quint64> top(count, linearColor(MaxLevel, MaxLevel, MaxLevel, MaxLevel));
+    QVector<quint32> residuals(count, 0xffffffff);
+    QVector<QRgb> colors(count, 0);
+    ColorCorrection::dither(top.constData(), residuals.data(), colors.data(), count);
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(colors.at(i), QRgb(0xffffffff));
+        QCOMPARE(residuals.at(i), quint32(0xffffffff));
+    }
+
+    top.fill(linearColor(MaxLevel - 1, MaxLevel - 1, MaxLevel - 1, MaxLevel - 1));
+    residuals.fill(0xffffffff);
+    ColorCorrection::dither(top.constData(), residuals.data(), colors.data(), count);
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(colors.at(i), QRgb(0xffffffff));
+        QCOMPARE(residuals.at(i), quint32(0xfefefefe));
+    }
+
+}
+
+/**
+ * @brief Checks that every vector implementation gives bit-identical colors and residuals to the scalar one in every frame.
+ * @details Skipped on processors without any vector instruction set.
+ */
+void ColorCorrectionTest::matchesScalar() {
+
+    if (CpuFeatures::supportedLevel() == CpuFeatures::Scalar) {QSKIP("The processor supports no vector instruction set.");}
+
+    const int count = linear.size();
+    for (int level = CpuFeatures::Sse2; level <= CpuFeatures::supportedLevel(); ++level) {
+        const char *isa = CpuFeatures::name(CpuFeatures::Level(level));
+        QVector<quint32> scalarResiduals(count, 0), residuals(count, 0);
+        QVector<QRgb> scalarColors(count), colors(count);
+        for (int frame = 0; frame < FrameCount; ++frame) { // Both start from no residual and run side by side, so that the residuals carried over are compared as well.
+            CpuFeatures::setLevel(CpuFeatures::Scalar);
+            ColorCorrection::dither(linear.constData(), scalarResiduals.data(), scalarColors.data(), count);
+            CpuFeatures::setLevel(CpuFeatures::Level(level));
+            ColorCorrection::dither(linear.constData(), residuals.data(), colors.data(), count);
+            for (int i = 0; i < count; ++i) { // Building the messages only on failure, as there are millions of checks.
+                if (colors.at(i) != scalarColors.at(i)) {QFAIL(qPrintable(QString("Color %1 of frame %2 differs between %3 and scalar").arg(i).arg(frame).arg(isa)));}
+                if (residuals.at(i) != scalarResiduals.at(i)) {QFAIL(qPrintable(QString("Residual %1 after frame %2 differs between %3 and scalar").arg(i).arg(frame).arg(isa)));}
+            }
+        }
+    }
+
+}
+
+/**
+ * @brief Checks that an LED taking over a freed slot starts its dithering without the removed LED's residual.
+ * @details The LED in the reused slot must show the same colors, frame by frame, as an LED of the same color in a store of its own, even though the removed LED left a residual behind after several frames.
+ */
+void ColorCorrectionTest::reusedSlotStartsOver() {
+
+    ColorCorrection::Parameters parameters;
+    parameters.gamma = 2.2;
+    parameters.brightness = 0.37; // A level with a fraction that takes many frames to come full circle.
+    const QRgb color = qRgb(77, 13, 150);
+
+    LedStore fresh;
+    OutputFrame freshOutput(fresh);
+    freshOutput.setCorrection(parameters);
+    freshOutput.setDithering(true);
+    fresh.setRgba(fresh.append(), color);
+    freshOutput.update();
+    fresh.clearDirty();
+
+    LedStore store;
+    OutputFrame output(store);
+    output.setCorrection(parameters);
+    output.setDithering(true);
+    QVERIFY(output.isDitheringActive());
+    for (int i = 0; i < 4; ++i) {store.setRgba(store.append(), color);}
+    output.update();
+    store.clearDirty();
+    for (int frame = 0; frame < 3; ++frame) {output.dither();} // Leaving a residual in every slot.
+
+    store.remove(2);
+    output.update();
+    store.clearDirty();
+    const int slot = store.append();
+    QCOMPARE(slot, 2);
+    store.setRgba(slot, color);
+    output.update();
+    store.clearDirty();
+
+    for (int frame = 0; frame < 8; ++frame) {
+        freshOutput.dither();
+        output.dither();
+        QCOMPARE(output.rgba(slot), freshOutput.rgba(0));
+    }
+
+}
+
+QTEST_APPLESS_MAIN(ColorCorrectionTest)
+
+#include "tst_colorcorrection.moc"
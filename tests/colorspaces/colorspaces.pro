@@ -0,0 +1,12 @@
+# Tests of the color space conversions at every supported instruction set, run with "make check".
+QT += testlib
+
+CONFIG += testcase
+CONFIG -= app_bundle
+
+TARGET = tst_colorspaces
+TEMPLATE = app
+
+include(../../Pilluminate.pri)
+
+SOURCES += tst_colorspaces.cpp
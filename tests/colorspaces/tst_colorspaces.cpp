@@ -0,0 +1,251 @@
+/**
+ * @file tst_colorspaces.cpp
+ * @brief Tests of the batch color space conversions.
+ * @details This file contains the ColorSpacesTest test case, which checks every instruction set the processor supports against the scalar implementation and against QColor, so that a regression in any kernel fails "make check".
+ * @author Group 3
+ */
+
+#include "include/utils/ColorSpaces.h"
+#include "include/utils/CpuFeatures.h"
+
+// Including necessary modules.
+#include <QColor>
+#include <QRandomGenerator>
+#include <QVector>
+#include <QtTest>
+
+namespace {
+
+const quint32 Seed = 42; // Fixed seed so that every run uses the same inputs.
+const int RandomCount = 100003; // Number of random colors, not a multiple of any vector width so that the scalar tails run as well.
+
+/**
+ * @brief Gets how far apart two colors are.
+ * @param a The first color.
+ * @param b The second color.
+ * @return The largest difference between their channels.
+ */
+int channelError(QRgb a, QRgb b) {
+    return qMax(qAbs(qRed(a) - qRed(b)), qMax(qAbs(qGreen(a) - qGreen(b)), qAbs(qBlue(a) - qBlue(b))));
+}
+
+/**
+ * @brief Gets how far apart two hues are around the color wheel.
+ * @param a The first hue, or -1 for a gray.
+ * @param b The second hue, or -1 for a gray.
+ * @return The difference in degrees, or 360 if only one of them is a gray.
+ */
+int hueError(int a, int b) {
+    if (a < 0 || b < 0) {return a == b ? 0 : 360;}
+    const int difference = qAbs(a - b);
+    return qMin(difference, 360 - difference);
+}
+
+}
+
+/**
+ * @class ColorSpacesTest
+ * @brief Checks ColorSpaces at every supported instruction set.
+ * @details The inputs are sweeps covering every hue, including the gray hue -1, combined with saturations and values or lightnesses in steps of 5, every RGB channel in steps of 3, and random colors. QColor converts the sweeps once, in initTestCase().
+ * @author Group 3
+ */
+class ColorSpacesTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Builds the inputs and the results QColor gives for them.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Restores the instruction set after each test.
+     */
+    void cleanup();
+
+    /**
+     * @brief Provides the supported instruction sets for matchesQColor().
+     */
+    void matchesQColor_data();
+
+    /**
+     * @brief Checks that every conversion is within one step of QColor.
+     * @details QColor rounds through 16-bit channels, so the kernels may differ from it by one step but no more.
+     */
+    void matchesQColor();
+
+    /**
+     * @brief Checks that every vector implementation gives bit-identical results to the scalar one.
+     */
+    void matchesScalar();
+
+private:
+
+    QVector<ColorSpaces::Hsv> hsvSweep; // HSV inputs covering every hue.
+    QVector<ColorSpaces::Hsl> hslSweep; // HSL inputs covering every hue.
+    QVector<QRgb> rgbSweep; // RGB inputs in steps of 3 per channel.
+    QVector<QRgb> expectedHsv; // QColor::fromHsv() of each HSV input.
+    QVector<QRgb> expectedHsl; // QColor::fromHsl() of each HSL input.
+    QVector<QColor> expectedRgb; // QColor of each RGB input, for its HSV components.
+    QVector<ColorSpaces::Hsv> hsvRandom; // Random HSV inputs.
+    QVector<ColorSpaces::Hsl> hslRandom; // Random HSL inputs.
+    QVector<QRgb> rgbRandom; // Random RGB inputs, with random alpha.
+
+    /**
+     * @brief Converts every input with the current instruction set.
+     * @param colors The RGB colors converted from the HSV and then the HSL inputs, sweeps first.
+     * @param hsv The HSV colors converted from the RGB inputs, sweep first.
+     */
+    void convertAll(QVector<QRgb> &colors, QVector<ColorSpaces::Hsv> &hsv) const;
+
+};
+
+/**
+ * @brief Builds the inputs and the results QColor gives for them.
+ */
+void ColorSpacesTest::initTestCase() {
+
+    for (int hue = -1; hue < 360; ++hue) {
+        for (int saturation = 0; saturation <= 255; saturation += 5) {
+            for (int level = 0; level <= 255; level += 5) {
+                hsvSweep.append({qint16(hue), quint8(saturation), quint8(level)});
+                hslSweep.append({qint16(hue), quint8(saturation), quint8(level)});
+                expectedHsv.append(QColor::fromHsv(hue, saturation, level).rgb());
+                expectedHsl.append(QColor::fromHsl(hue, saturation, level).rgb());
+            }
+        }
+    }
+    for (int r = 0; r <= 255; r += 3) {
+        for (int g = 0; g <= 255; g += 3) {
+            for (int b = 0; b <= 255; b += 3) {
+                rgbSweep.append(qRgb(r, g, b));
+                expectedRgb.append(QColor(r, g, b));
+            }
+        }
+    }
+
+    QRandomGenerator random(Seed);
+    for (int i = 0; i < RandomCount; ++i) {
+        const quint32 bits = random.generate();
+        const qint16 hue = qint16(random.bounded(-1, 360));
+        hsvRandom.append({hue, quint8(bits), quint8(bits >> 8)});
+        hslRandom.append({hue, quint8(bits >> 16), quint8(bits >> 24)});
+        rgbRandom.append(random.generate());
+    }
+
+}
+
+/**
+ * @brief Restores the instruction set after each test.
+ */
+void ColorSpacesTest::cleanup() {
+    CpuFeatures::setLevel(CpuFeatures::supportedLevel());
+}
+
+/**
+ * @brief Converts every input with the current instruction set.
+ * @param colors Receives the RGB colors.
+ * @param hsv Receives the HSV colors.
+ */
+void ColorSpacesTest::convertAll(QVector<QRgb> &colors, QVector<ColorSpaces::Hsv> &hsv) const {
+    colors.resize(hsvSweep.size() + hslSweep.size() + 2 * RandomCount);
+    hsv.resize(rgbSweep.size() + RandomCount);
+    QRgb *rgb = colors.data();
+    ColorSpaces::hsvToRgb(hsvSweep.constData(), rgb, hsvSweep.size());
+    rgb += hsvSweep.size();
+    ColorSpaces::hslToRgb(hslSweep.constData(), rgb, hslSweep.size());
+    rgb += hslSweep.size();
+    ColorSpaces::hsvToRgb(hsvRandom.constData(), rgb, RandomCount);
+    ColorSpaces::hslToRgb(hslRandom.constData(), rgb + RandomCount, RandomCount);
+    ColorSpaces::rgbToHsv(rgbSweep.constData(), hsv.data(), rgbSweep.size());
+    ColorSpaces::rgbToHsv(rgbRandom.constData(), hsv.data() + rgbSweep.size(), RandomCount);
+}
+
+/**
+ * @brief Provides the supported instruction sets for matchesQColor().
+ */
+void ColorSpacesTest::matchesQColor_data() {
+    QTest::addColumn<int>("level");
+    for (int level = CpuFeatures::Scalar; level <= CpuFeatures::supportedLevel(); ++level) {
+        QTest::newRow(CpuFeatures::name(CpuFeatures::Level(level))) << level;
+    }
+}
+
+/**
+ * @brief Checks that every conversion is within one step of QColor.
+ * @details The first input that is off by more than one step is named in the failure message.
+ */
+void ColorSpacesTest::matchesQColor() {
+
+    QFETCH(int, level);
+    CpuFeatures::setLevel(CpuFeatures::Level(level));
+
+    QVector<QRgb> colors(hsvSweep.size());
+    ColorSpaces::hsvToRgb(hsvSweep.constData(), colors.data(), hsvSweep.size());
+    for (int i = 0; i < hsvSweep.size(); ++i) {
+        const ColorSpaces::Hsv &input = hsvSweep.at(i);
+        QVERIFY2(channelError(colors.at(i), expectedHsv.at(i)) <= 1,
+                 qPrintable(QString("HSV (%1, %2, %3) converts to #%4 instead of #%5")
+                            .arg(input.hue).arg(input.saturation).arg(input.value).arg(colors.at(i) & 0xffffff, 6, 16, QChar('0')).arg(expectedHsv.at(i) & 0xffffff, 6, 16, QChar('0'))));
+    }
+
+    colors.resize(hslSweep.size());
+    ColorSpaces::hslToRgb(hslSweep.constData(), colors.data(), hslSweep.size());
+    for (int i = 0; i < hslSweep.size(); ++i) {
+        const ColorSpaces::Hsl &input = hslSweep.at(i);
+        QVERIFY2(channelError(colors.at(i), expectedHsl.at(i)) <= 1,
+                 qPrintable(QString("HSL (%1, %2, %3) converts to #%4 instead of #%5")
+                            .arg(input.hue).arg(input.saturation).arg(input.lightness).arg(colors.at(i) & 0xffffff, 6, 16, QChar('0')).arg(expectedHsl.at(i) & 0xffffff, 6, 16, QChar('0'))));
+    }
+
+    QVector<ColorSpaces::Hsv> hsv(rgbSweep.size());
+    ColorSpaces::rgbToHsv(rgbSweep.constData(), hsv.data(), rgbSweep.size());
+    for (int i = 0; i < rgbSweep.size(); ++i) {
+        const QColor &expected = expectedRgb.at(i);
+        const ColorSpaces::Hsv &actual = hsv.at(i);
+        const int error = qMax(hueError(actual.hue, expected.hsvHue()), qMax(qAbs(actual.saturation - expected.hsvSaturation()), qAbs(actual.value - expected.value())));
+        QVERIFY2(error <= 1,
+                 qPrintable(QString("RGB #%1 converts to HSV (%2, %3, %4) instead of (%5, %6, %7)")
+                            .arg(rgbSweep.at(i) & 0xffffff, 6, 16, QChar('0')).arg(actual.hue).arg(actual.saturation).arg(actual.value)
+                            .arg(expected.hsvHue()).arg(expected.hsvSaturation()).arg(expected.value())));
+    }
+
+}
+
+/**
+ * @brief Checks that every vector implementation gives bit-identical results to the scalar one.
+ * @details Skipped on processors without any vector instruction set.
+ */
+void ColorSpacesTest::matchesScalar() {
+
+    if (CpuFeatures::supportedLevel() == CpuFeatures::Scalar) {QSKIP("The processor supports no vector instruction set.");}
+
+    QVector<QRgb> scalarColors;
+    QVector<ColorSpaces::Hsv> scalarHsv;
+    CpuFeatures::setLevel(CpuFeatures::Scalar);
+    convertAll(scalarColors, scalarHsv);
+
+    for (int level = CpuFeatures::Sse2; level <= CpuFeatures::supportedLevel(); ++level) {
+        CpuFeatures::setLevel(CpuFeatures::Level(level));
+        const char *isa = CpuFeatures::name(CpuFeatures::Level(level));
+        QVector<QRgb> colors;
+        QVector<ColorSpaces::Hsv> hsv;
+        convertAll(colors, hsv);
+        for (int i = 0; i < colors.size(); ++i) {
+            QVERIFY2(colors.at(i) == scalarColors.at(i), qPrintable(QString("RGB color %1 differs between %2 and scalar").arg(i).arg(isa)));
+        }
+        for (int i = 0; i < hsv.size(); ++i) {
+            const ColorSpaces::Hsv &actual = hsv.at(i);
+            const ColorSpaces::Hsv &expected = scalarHsv.at(i);
+            QVERIFY2(actual.hue == expected.hue && actual.saturation == expected.saturation && actual.value == expected.value,
+                     qPrintable(QString("HSV color %1 differs between %2 and scalar").arg(i).arg(isa)));
+        }
+    }
+
+}
+
+QTEST_APPLESS_MAIN(ColorSpacesTest)
+
+#include "tst_colorspaces.moc"
@@ -0,0 +1,12 @@
+# Tests of the built-in effects at every supported instruction set, run with "make check".
+QT += testlib
+
+CONFIG += testcase
+CONFIG -= app_bundle
+
+TARGET = tst_effects
+TEMPLATE = app
+
+include(../../Pilluminate.pri)
+
+SOURCES += tst_effects.cpp
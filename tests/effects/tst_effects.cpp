@@ -0,0 +1,146 @@
+/**
+ * @file tst_effects.cpp
+ * @brief Tests of the built-in effects.
+ * @details This file contains the EffectsTest test case, which renders every effect at every instruction set the processor supports and checks it against the scalar implementation, so that a regression in any effect kernel fails "make check".
+ * @author Group 3
+ */
+
+#include "include/models/Effects.h"
+#include "include/utils/CpuFeatures.h"
+
+// Including necessary modules.
+#include <QSharedPointer>
+#include <QVector>
+#include <QtTest>
+
+namespace {
+
+const QRgb Sentinel = 0x12345678; // Color no effect writes, as effects write opaque colors only, marking LEDs outside the rendered ranges.
+const int Sizes[] = {1, 67, 4099, 70001}; // Numbers of LEDs, none a multiple of any vector width so that the scalar tails run as well.
+const qint64 Times[] = {0, 777, 123457}; // Frame times in milliseconds, so that every effect is caught at several phases.
+const int Lengths[] = {1, 3, 61, 1001}; // Lengths of the first ranges of a frame, so that the later ranges start at odd positions.
+const int Tail = 5; // Number of LEDs at the end of a frame left unrendered.
+
+/**
+ * @brief Renders a frame in ranges, the way the engine's threads split it.
+ * @details The ranges have the lengths in Lengths, clipped to the frame, followed by one range up to the last Tail LEDs, which keep the sentinel.
+ * @param effect The effect to render.
+ * @param context The frame being rendered.
+ * @param colors Receives the colors of the frame.
+ */
+void renderRanges(const Effect &effect, const Effect::Context &context, QVector<QRgb> &colors) {
+    colors.fill(Sentinel, context.size);
+    const int end = qMax(0, context.size - Tail);
+    int first = 0;
+    for (int length : Lengths) {
+        length = qMin(length, end - first);
+        if (length > 0) {effect.render(context, colors.data(), first, length);}
+        first += length;
+    }
+    if (first < end) {effect.render(context, colors.data(), first, end - first);}
+}
+
+}
+
+/**
+ * @class EffectsTest
+ * @brief Checks every effect at every supported instruction set.
+ * @details Each effect is created once with the default parameters and once with colors of its own, and rendered at several numbers of LEDs and frame times.
+ * @author Group 3
+ */
+class EffectsTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Restores the instruction set after each test.
+     */
+    void cleanup();
+
+    /**
+     * @brief Provides the effects for matchesScalar().
+     */
+    void matchesScalar_data();
+
+    /**
+     * @brief Checks that every vector implementation gives bit-identical colors to the scalar one.
+     * @details The frames are rendered in ranges with odd lengths and non-zero first positions, and compared with the scalar implementation rendering each frame as a whole, so that the ranges are also checked to line up into one continuous pattern and to leave the LEDs outside them alone.
+     */
+    void matchesScalar();
+
+};
+
+/**
+ * @brief Restores the instruction set after each test.
+ */
+void EffectsTest::cleanup() {
+    CpuFeatures::setLevel(CpuFeatures::supportedLevel());
+}
+
+/**
+ * @brief Provides the effects for matchesScalar().
+ */
+void EffectsTest::matchesScalar_data() {
+
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<bool>("defaults");
+
+    for (const QString &name : Effects::names()) {
+        QTest::newRow(qPrintable(name + " with defaults")) << name << true;
+        QTest::newRow(qPrintable(name + " with colors")) << name << false;
+    }
+
+}
+
+/**
+ * @brief Checks that every vector implementation gives bit-identical colors to the scalar one.
+ * @details Runs the scalar implementation against itself on processors without any vector instruction set, which still checks the ranges.
+ */
+void EffectsTest::matchesScalar() {
+
+    QFETCH(QString, name);
+    QFETCH(bool, defaults);
+
+    Effects::Parameters parameters;
+    if (!defaults) {
+        parameters.color = qRgb(200, 90, 17);
+        parameters.secondColor = qRgb(3, 250, 128);
+        parameters.period = 1500;
+        parameters.length = 37;
+    }
+    const QSharedPointer<const Effect> effect = Effects::create(name, parameters);
+    QVERIFY(effect);
+
+    QVector<QRgb> expected;
+    QVector<QRgb> colors;
+    for (int size : Sizes) {
+        for (qint64 time : Times) {
+
+            const Effect::Context context = {time, quint64(time / 16 + 1), size};
+            CpuFeatures::setLevel(CpuFeatures::Scalar);
+            expected.fill(Sentinel, size);
+            effect->render(context, expected.data(), 0, size);
+            for (int i = qMax(0, size - Tail); i < size; ++i) {expected[i] = Sentinel;} // Left unrendered by renderRanges().
+
+            for (int level = CpuFeatures::Scalar; level <= CpuFeatures::supportedLevel(); ++level) {
+                CpuFeatures::setLevel(CpuFeatures::Level(level));
+                renderRanges(*effect, context, colors);
+                for (int i = 0; i < size; ++i) { // Building the message only on failure, as there are many checks.
+                    if (colors.at(i) != expected.at(i)) {
+                        QFAIL(qPrintable(QString("LED %1 of %2 at %3 ms is #%4 with %5 instead of #%6 with scalar")
+                                         .arg(i).arg(size).arg(time).arg(colors.at(i), 8, 16, QChar('0'))
+                                         .arg(CpuFeatures::name(CpuFeatures::Level(level))).arg(expected.at(i), 8, 16, QChar('0'))));
+                    }
+                }
+            }
+
+        }
+    }
+
+}
+
+QTEST_APPLESS_MAIN(EffectsTest)
+
+#include "tst_effects.moc"
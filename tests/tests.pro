@@ -0,0 +1,6 @@
+TEMPLATE = subdirs
+
+SUBDIRS += benchmarks \
+           colorcorrection \
+           colorspaces \
+           effects